@@ -0,0 +1,65 @@
+#!/bin/bash
+#
+# Strong scaling of the offline NoahMP driver, started from the six C96 tiles
+# in test/Data. The tiles are first put on the vector of land locations with
+# convert_restart_tiles2vec.x, unless a vector restart is given, then
+# ufsLandDriver.x is restarted from them for each number of processes and
+# threads. The timings it reports and the checksums of the output are
+# collected in scaling.txt, the output of every run has to match the first.
+#
+# usage: scaling_benchmark.sh <bin dir> <ufs-land.namelist> [procs] [threads] [restart]
+#
+# The namelist gives the static file, the forcing and the run length of the
+# C96 setup, the restart settings are overwritten here. The output goes to
+# the run directory, output_dir = "./".
+
+set -e
+
+bindir=$(readlink -f $1)
+namelist=$(readlink -f $2)
+procs=${3:-"1 2 4 8"}
+threads=${4:-"1 2 4"}
+restart=${5:+$(readlink -f $5)}
+
+datadir=$(readlink -f $(dirname $0)/../../../test/Data)
+tiles=${datadir}/ufs_land_output.2013-10-01_00-00-00
+restart_date="2013-10-01 00:00:00"
+
+mkdir -p ./scaling/restart
+cd ./scaling
+if [ -n "${restart}" ]; then
+  cp ${restart} ./restart/ufs_land_restart.2013-10-01_00-00-00.nc
+else
+  ${bindir}/convert_restart_tiles2vec.x ${tiles} \
+            ./restart/ufs_land_restart.2013-10-01_00-00-00.nc
+fi
+
+sed -e "s|^ *restart_simulation *=.*|  restart_simulation = .true.|" \
+    -e "s|^ *restart_date *=.*|  restart_date = \"${restart_date}\"|" \
+    -e "s|^ *restart_dir *=.*|  restart_dir = \"./restart/\"|" \
+    -e "s|^ *restart_frequency_s *=.*|  restart_frequency_s = 0|" \
+    ${namelist} > ./ufs-land.namelist
+
+rm -f scaling.txt reference.md5
+status=0
+for np in ${procs}; do
+  for nt in ${threads}; do
+    rm -f ufs_land_output.*.nc
+    start=$(date +%s.%N)
+    OMP_NUM_THREADS=${nt} mpirun -np ${np} ${bindir}/ufsLandDriver.x > run_${np}x${nt}.log
+    end=$(date +%s.%N)
+    md5sum ufs_land_output.*.nc > run_${np}x${nt}.md5
+    [ -f reference.md5 ] || cp run_${np}x${nt}.md5 reference.md5
+    if cmp -s reference.md5 run_${np}x${nt}.md5; then
+      result="identical"
+    else
+      result="DIFFERENT"
+      status=1
+    fi
+    echo "procs ${np} threads ${nt} wall $(awk "BEGIN {print ${end} - ${start}}") s" \
+         "output ${result}" >> scaling.txt
+    grep "^Timing" run_${np}x${nt}.log >> scaling.txt
+  done
+done
+cat reference.md5 scaling.txt
+exit ${status}
@@ -2,6 +2,7 @@ module ufsLandForcingModule
 
 use machine ,   only : kind_phys
 use NamelistRead
+use ufsLandForcingReaderModule, only : forcing_reader_type
 
 implicit none
 save
@@ -9,7 +10,6 @@ private
 
 type, public :: forcing_type
 
-  integer                          :: forcing_counter
   integer                          :: nlocations
   double precision                 :: time
   real(kind=kind_phys), allocatable, dimension(:)  :: temperature
@@ -25,9 +25,12 @@ type, public :: forcing_type
 
     procedure, public  :: ReadForcingInit
     procedure, public  :: ReadForcing
+    procedure, public  :: ReadForcingFinalize
 
 end type forcing_type
 
+  type(forcing_reader_type)        :: reader
+
   double precision                 :: last_time
   character*19                     :: last_date  ! format: yyyy-mm-dd hh:nn:ss
   logical                          :: last_forcing_read
@@ -62,11 +65,7 @@ contains
   
   character*128        :: forcing_filename
   
-  double precision     :: read_time
-  
-  integer :: ncid, dimid, varid, status, ntimes, itime
-  
-  this%forcing_counter = 0
+  integer :: ncid, dimid, status
   
   forcing_type_option : select case (trim(namelist%forcing_type))
     case ("single_point")
@@ -116,42 +115,20 @@ contains
   allocate(next_downward_shortwave(namelist%lensub))
   allocate(next_precipitation     (namelist%lensub))
 
-  status = nf90_inq_dimid(ncid, "time", dimid)
-   if (status /= nf90_noerr) call handle_err(status)
-
-  status = nf90_inquire_dimension(ncid, dimid, len = ntimes)
-   if (status /= nf90_noerr) call handle_err(status)
-   
-  status = nf90_inq_varid(ncid, "time", varid)
-   if(status /= nf90_noerr) call handle_err(status)
-
-  timeloop : do itime = 1, ntimes
-  
-    status = nf90_get_var(ncid, varid, read_time, start = (/itime/))
-     if(status /= nf90_noerr) call handle_err(status)
-     
-    if (read_time == namelist%initial_time + namelist%timestep_seconds) then
-       this%forcing_counter = itime
-       next_time = read_time
-       last_time = huge(1.d0)
-       next_forcing_read = .false.
-       last_forcing_read = .false.
-       exit timeloop
-    end if
-    
-  end do timeloop
-  
   status = nf90_close(ncid)
    if (status /= nf90_noerr) call handle_err(status)
 
-  if(this%forcing_counter == 0) stop "did not find initial forcing time in file"
+  next_time = namelist%initial_time + namelist%timestep_seconds
+  last_time = huge(1.d0)
+  next_forcing_read = .false.
+  last_forcing_read = .false.
+
+  call reader%Open(namelist, next_time)
    
   end subroutine ReadForcingInit
 
   subroutine ReadForcing(this, namelist, static, now_time)
   
-  use netcdf
-  use error_handling, only : handle_err
   use time_utilities
   use interpolation_utilities, only : interpolate_linear, interpolate_gswp3_zenith
   use ufsLandStaticModule, only : static_type
@@ -161,11 +138,8 @@ contains
   type (static_type)   :: static
   double precision     :: now_time
   
-  character*128        :: forcing_filename
   character*19         :: now_date  ! format: yyyy-mm-dd hh:nn:ss
   
-  integer :: ncid, dimid, varid, status
-  integer :: times_in_file
   double precision  :: file_next_time
   
   call date_from_since("1970-01-01 00:00:00", now_time, now_date)
@@ -175,76 +149,14 @@ contains
   
   if(.not. next_forcing_read) then
   
-    forcing_type_option : select case (trim(namelist%forcing_type))
-      case ("single_point")
-        forcing_filename = trim(namelist%forcing_dir)//"/"//trim(namelist%forcing_filename)
-      case ("gswp3")
-        forcing_filename = trim(namelist%forcing_dir)//"/"//trim(namelist%forcing_filename)
-        forcing_filename = trim(forcing_filename)//next_date(1:7)//".nc"
-        if(next_date(9:19) == "01 00:00:00") then
-          this%forcing_counter = 1
-          write(*,*) "Resetting forcing counter to beginning of file"
-        end if
-      case default
-        stop "namelist forcing_type not recognized"
-    end select forcing_type_option
-  
-    status = nf90_open(forcing_filename, NF90_NOWRITE, ncid)
-     if (status /= nf90_noerr) call handle_err(status)
-  
-    status = nf90_inq_varid(ncid, "time", varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, file_next_time, start = (/this%forcing_counter/))
-     if(status /= nf90_noerr) call handle_err(status)
+    call reader%Get(file_next_time, next_temperature, next_specific_humidity,      &
+                    next_surface_pressure, next_wind_speed, next_downward_longwave, &
+                    next_downward_shortwave, next_precipitation)
      
     if(file_next_time /= next_time) then
       write(*,*) "file_next_time not equal to next_time in now_time == next_time forcing"
       stop
     end if
-   
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_temperature), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_temperature, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-  
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_specific_humidity), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_specific_humidity, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-  
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_pressure), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_surface_pressure, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-  
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_wind_speed), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_wind_speed, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-  
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_lw_radiation), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_downward_longwave, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_sw_radiation), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_downward_shortwave, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-  
-    status = nf90_inq_varid(ncid, trim(namelist%forcing_name_precipitation), varid)
-     if(status /= nf90_noerr) call handle_err(status)
-    status = nf90_get_var(ncid, varid, next_precipitation, &
-        start = (/namelist%begsub,this%forcing_counter/), count = (/namelist%lensub, 1/))
-     if(status /= nf90_noerr) call handle_err(status)
-
-    status = nf90_close(ncid)
 
     next_forcing_read = .true.
     
@@ -281,8 +193,6 @@ contains
     next_time = last_time + namelist%forcing_timestep_seconds
     last_forcing_read = .true.
     next_forcing_read = .false.
-  
-    this%forcing_counter = this%forcing_counter + 1   ! increment forcing counter by 1
 
   elseif(now_time < next_time) then
   
@@ -331,4 +241,12 @@ contains
   
   end subroutine ReadForcing
 
+  subroutine ReadForcingFinalize(this)
+  
+  class(forcing_type)  :: this
+  
+  call reader%Close()
+  
+  end subroutine ReadForcingFinalize
+
 end module ufsLandForcingModule
@@ -0,0 +1,378 @@
+module ufsLandForcingReaderModule
+
+! Reader of the forcing records for ufsLandForcingModule. The current
+! forcing file stays open with its variable ids and its time axis, and the
+! next records are read ahead into a ring of nslots buffers. When a file has
+! no more records the gswp3 forcing goes on with the next monthly file.
+!
+! With async the read ahead is an OpenMP task, run by an idle thread of the
+! enclosing parallel region (see ufsLandNoahMPDriverRun) while the model goes
+! on. Only one read ahead task runs at a time. It only touches the slots
+! that are empty, the slot states are the only variables shared with Get,
+! and the netcdf calls are made in the ufsland_netcdf critical section.
+
+  use machine, only : kind_phys
+  use netcdf
+  use error_handling, only : handle_err
+
+  implicit none
+  save
+  private
+
+  integer, parameter, public :: forcing_nvars = 7
+  integer, parameter, public :: forcing_temperature        = 1
+  integer, parameter, public :: forcing_specific_humidity  = 2
+  integer, parameter, public :: forcing_surface_pressure   = 3
+  integer, parameter, public :: forcing_wind_speed         = 4
+  integer, parameter, public :: forcing_downward_longwave  = 5
+  integer, parameter, public :: forcing_downward_shortwave = 6
+  integer, parameter, public :: forcing_precipitation      = 7
+
+  integer, parameter :: slot_empty = 0
+  integer, parameter :: slot_ready = 1
+
+  type, public :: forcing_reader_type
+
+    character*128    :: forcing_type
+    character*128    :: forcing_path      ! directory and file name, without the month for gswp3
+    character*128, dimension(forcing_nvars) :: names
+    integer          :: begsub, lensub
+    double precision :: timestep_seconds
+    logical          :: async
+
+! current file, only used by ReadAhead once open
+
+    integer          :: ncid
+    logical          :: file_open = .false.
+    integer          :: time_varid
+    integer, dimension(forcing_nvars) :: varids
+    integer          :: ntimes
+    integer          :: record            ! next record of the file to read
+    double precision, allocatable, dimension(:) :: file_times
+    double precision :: last_read_time
+
+! ring of records read ahead, filled at tail by ReadAhead, emptied at head by Get
+
+    integer          :: nslots
+    real(kind=kind_phys), allocatable, dimension(:,:,:) :: values  ! (lensub,forcing_nvars,nslots)
+    double precision,     allocatable, dimension(:)     :: times   ! (nslots)
+    integer,              allocatable, dimension(:)     :: state   ! (nslots)
+    integer          :: head = 1
+    integer          :: tail = 1
+    logical          :: producing = .false.
+    logical          :: no_more_records = .false.
+
+! read statistics
+
+    integer          :: records_read = 0
+    double precision :: read_seconds = 0.d0
+
+  contains
+
+    procedure, public  :: Open => OpenReader
+    procedure, public  :: Get
+    procedure, public  :: Close => CloseReader
+    procedure          :: OpenFile
+    procedure          :: Prefetch
+    procedure          :: ReadAhead
+
+  end type forcing_reader_type
+
+contains
+
+! Open the file holding first_time, position on that record and start
+! reading ahead
+
+  subroutine OpenReader(this, namelist, first_time)
+
+  use NamelistRead
+
+  class(forcing_reader_type) :: this
+  type(namelist_type)  :: namelist
+  double precision     :: first_time
+
+  this%forcing_type     = namelist%forcing_type
+  this%forcing_path     = trim(namelist%forcing_dir)//"/"//trim(namelist%forcing_filename)
+  this%begsub           = namelist%begsub
+  this%lensub           = namelist%lensub
+  this%timestep_seconds = namelist%forcing_timestep_seconds
+  this%async            = namelist%forcing_async
+  this%nslots           = max(namelist%forcing_prefetch_records, 1)
+
+  this%names(forcing_temperature)        = namelist%forcing_name_temperature
+  this%names(forcing_specific_humidity)  = namelist%forcing_name_specific_humidity
+  this%names(forcing_surface_pressure)   = namelist%forcing_name_pressure
+  this%names(forcing_wind_speed)         = namelist%forcing_name_wind_speed
+  this%names(forcing_downward_longwave)  = namelist%forcing_name_lw_radiation
+  this%names(forcing_downward_shortwave) = namelist%forcing_name_sw_radiation
+  this%names(forcing_precipitation)      = namelist%forcing_name_precipitation
+
+  allocate(this%values(this%lensub, forcing_nvars, this%nslots))
+  allocate(this%times(this%nslots))
+  allocate(this%state(this%nslots))
+  this%state = slot_empty
+  this%head  = 1
+  this%tail  = 1
+  this%producing       = .false.
+  this%no_more_records = .false.
+  this%records_read    = 0
+  this%read_seconds    = 0.d0
+
+  !$omp critical (ufsland_netcdf)
+  call this%OpenFile(first_time)
+  !$omp end critical (ufsland_netcdf)
+
+  call this%Prefetch()
+
+  end subroutine OpenReader
+
+! Open the file holding time, read its time axis and search it for time
+
+  subroutine OpenFile(this, time)
+
+  use time_utilities, only : date_from_since
+
+  class(forcing_reader_type) :: this
+  double precision     :: time
+  character*256        :: filename
+  character*19         :: date
+  integer :: status, dimid, ivar, lo, hi, mid
+
+  forcing_type_option : select case (trim(this%forcing_type))
+    case ("single_point")
+      filename = this%forcing_path
+    case ("gswp3")
+      call date_from_since("1970-01-01 00:00:00", time, date)
+      filename = trim(this%forcing_path)//date(1:7)//".nc"
+    case default
+      stop "namelist forcing_type not recognized"
+  end select forcing_type_option
+
+  if(this%file_open) then
+    status = nf90_close(this%ncid)
+     if (status /= nf90_noerr) call handle_err(status)
+    this%file_open = .false.
+  end if
+
+  write(*,*) "Opening forcing file: "//trim(filename)
+
+  status = nf90_open(filename, NF90_NOWRITE, this%ncid)
+   if (status /= nf90_noerr) call handle_err(status)
+  this%file_open = .true.
+
+  status = nf90_inq_dimid(this%ncid, "time", dimid)
+   if (status /= nf90_noerr) call handle_err(status)
+  status = nf90_inquire_dimension(this%ncid, dimid, len = this%ntimes)
+   if (status /= nf90_noerr) call handle_err(status)
+
+  status = nf90_inq_varid(this%ncid, "time", this%time_varid)
+   if (status /= nf90_noerr) call handle_err(status)
+
+  do ivar = 1, forcing_nvars
+    status = nf90_inq_varid(this%ncid, trim(this%names(ivar)), this%varids(ivar))
+     if (status /= nf90_noerr) call handle_err(status)
+  end do
+
+  if(allocated(this%file_times)) deallocate(this%file_times)
+  allocate(this%file_times(this%ntimes))
+
+  status = nf90_get_var(this%ncid, this%time_varid, this%file_times)
+   if (status /= nf90_noerr) call handle_err(status)
+
+! the times are increasing
+
+  this%record = 0
+  lo = 1
+  hi = this%ntimes
+  do while(lo <= hi)
+    mid = (lo + hi) / 2
+    if(this%file_times(mid) == time) then
+      this%record = mid
+      exit
+    elseif(this%file_times(mid) < time) then
+      lo = mid + 1
+    else
+      hi = mid - 1
+    end if
+  end do
+
+  if(this%record == 0) stop "did not find forcing time in file"
+
+  end subroutine OpenFile
+
+! Start reading ahead, unless it is already going on. Without async the
+! empty slots are filled before returning.
+
+  subroutine Prefetch(this)
+
+  class(forcing_reader_type) :: this
+  logical :: producing
+
+  !$omp atomic read
+  producing = this%producing
+  if(producing) return
+
+  !$omp atomic write
+  this%producing = .true.
+
+  !$omp task default(shared) if(this%async)
+  call this%ReadAhead()
+  !$omp end task
+
+  end subroutine Prefetch
+
+! Fill the empty slots, in order, with the next records
+
+  subroutine ReadAhead(this)
+
+  class(forcing_reader_type) :: this
+  integer :: status, ivar, state
+  integer(kind=8) :: count_start, count_end, count_rate
+
+  call system_clock(count_start, count_rate)
+
+  do
+
+    !$omp atomic read
+    state = this%state(this%tail)
+    if(state == slot_ready) exit     ! the ring is full
+
+    !$omp critical (ufsland_netcdf)
+
+    if(this%record > this%ntimes) then
+      if(trim(this%forcing_type) == "gswp3") then
+        call this%OpenFile(this%last_read_time + this%timestep_seconds)
+      else
+        !$omp atomic write
+        this%no_more_records = .true.
+      end if
+    end if
+
+    if(this%record <= this%ntimes) then
+      do ivar = 1, forcing_nvars
+        status = nf90_get_var(this%ncid, this%varids(ivar), this%values(:, ivar, this%tail), &
+            start = (/this%begsub, this%record/), count = (/this%lensub, 1/))
+         if (status /= nf90_noerr) call handle_err(status)
+      end do
+    end if
+
+    !$omp end critical (ufsland_netcdf)
+
+    if(this%record > this%ntimes) exit
+
+    this%times(this%tail) = this%file_times(this%record)
+    this%last_read_time   = this%file_times(this%record)
+    this%record           = this%record + 1
+    this%records_read     = this%records_read + 1
+
+    !$omp flush
+    !$omp atomic write
+    this%state(this%tail) = slot_ready
+
+    this%tail = mod(this%tail, this%nslots) + 1
+
+  end do
+
+  call system_clock(count_end)
+  this%read_seconds = this%read_seconds + dble(count_end - count_start) / dble(count_rate)
+
+  !$omp flush
+  !$omp atomic write
+  this%producing = .false.
+
+  end subroutine ReadAhead
+
+! Take the next record, waiting for it if it has not been read yet
+
+  subroutine Get(this, time, temperature, specific_humidity, surface_pressure, wind_speed, &
+                 downward_longwave, downward_shortwave, precipitation)
+
+  class(forcing_reader_type) :: this
+  double precision     :: time
+  real(kind=kind_phys), dimension(:) :: temperature, specific_humidity, surface_pressure,  &
+                                        wind_speed, downward_longwave, downward_shortwave, &
+                                        precipitation
+  integer :: state
+  logical :: producing, no_more_records
+
+  do
+    !$omp atomic read
+    state = this%state(this%head)
+    if(state == slot_ready) exit
+
+    !$omp atomic read
+    producing = this%producing
+    if(.not.producing) then
+      !$omp atomic read
+      state = this%state(this%head)
+      if(state == slot_ready) exit
+      !$omp atomic read
+      no_more_records = this%no_more_records
+      if(no_more_records) stop "no more records in forcing file"
+      call this%Prefetch()
+    end if
+
+    !$omp taskyield
+  end do
+
+  !$omp flush
+
+  associate(values => this%values(:, :, this%head))
+  time               = this%times(this%head)
+  temperature        = values(:, forcing_temperature)
+  specific_humidity  = values(:, forcing_specific_humidity)
+  surface_pressure   = values(:, forcing_surface_pressure)
+  wind_speed         = values(:, forcing_wind_speed)
+  downward_longwave  = values(:, forcing_downward_longwave)
+  downward_shortwave = values(:, forcing_downward_shortwave)
+  precipitation      = values(:, forcing_precipitation)
+  end associate
+
+  !$omp flush
+  !$omp atomic write
+  this%state(this%head) = slot_empty
+
+  this%head = mod(this%head, this%nslots) + 1
+
+  call this%Prefetch()
+
+  end subroutine Get
+
+! Wait for the read ahead, close the file and print the read throughput
+
+  subroutine CloseReader(this)
+
+  use ufsLandMPIModule, only : mpi_rank
+
+  class(forcing_reader_type) :: this
+  integer :: status
+  logical :: producing
+  double precision :: mbytes
+
+  do
+    !$omp atomic read
+    producing = this%producing
+    if(.not.producing) exit
+    !$omp taskyield
+  end do
+
+  !$omp flush
+
+  if(this%file_open) then
+    !$omp critical (ufsland_netcdf)
+    status = nf90_close(this%ncid)
+    !$omp end critical (ufsland_netcdf)
+    this%file_open = .false.
+  end if
+
+  mbytes = dble(this%records_read) * forcing_nvars * this%lensub * storage_size(1.0_kind_phys) / 8.d6
+
+  if(mpi_rank == 0) write(*,'(a,i8,a,f10.1,a,f10.3,a,f10.1,a)') "Forcing read: ", &
+     this%records_read, " records, ", mbytes, " MB in ", this%read_seconds, " s, ",  &
+     mbytes / max(this%read_seconds, 1.d-9), " MB/s"
+
+  deallocate(this%values, this%times, this%state)
+
+  end subroutine CloseReader
+
+end module ufsLandForcingReaderModule
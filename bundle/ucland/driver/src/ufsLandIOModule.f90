@@ -1,5 +1,7 @@
 module ufsLandIOModule
 
+  use ufsLandWriterModule, only : output_writer_type
+
   implicit none
   save
   private
@@ -7,12 +9,13 @@ module ufsLandIOModule
   type, public :: output_type
 
     character*256    :: filename
-    integer          :: output_counter
+    type(output_writer_type) :: writer
 
   contains
 
     procedure, public  :: WriteOutputNoah
     procedure, public  :: WriteOutputNoahMP
+    procedure, public  :: CloseOutput
 
 end type output_type
      
@@ -20,9 +23,7 @@ contains
 
   subroutine WriteOutputNoah(this, namelist, noah, forcing, now_time)
   
-  use netcdf
   use time_utilities
-  use error_handling, only : handle_err
   use NamelistRead
   use ufsLandNoahType
   use ufsLandForcingModule
@@ -35,9 +36,6 @@ contains
   character*19     :: nowdate    ! current date
   character*19     :: reference_date = "1970-01-01 00:00:00"
   integer          :: yyyy,mm,dd,hh,nn,ss
-  integer :: ncid, dimid, varid, status
-  integer :: dim_id_time, dim_id_loc, dim_id_soil, dim_id_date
-  integer :: outsub
   
   if(now_time == namelist%initial_time + namelist%timestep_seconds .or. &
      namelist%separate_output) then
@@ -55,464 +53,128 @@ contains
 
     this%filename = trim(namelist%output_dir)//"/"//trim(this%filename)
 
-    write(*,*) "Creating: "//trim(this%filename)
-
-    status = nf90_create(this%filename, NF90_CLOBBER, ncid)
-      if (status /= nf90_noerr) call handle_err(status)
-
-! Define dimensions in the file.
-
-    status = nf90_def_dim(ncid, "location"   , noah%static%im        , dim_id_loc)
-      if (status /= nf90_noerr) call handle_err(status)
-    status = nf90_def_dim(ncid, "soil_levels"   , noah%static%km     , dim_id_soil)
-      if (status /= nf90_noerr) call handle_err(status)
-    status = nf90_def_dim(ncid, "time"       , NF90_UNLIMITED        , dim_id_time)
-      if (status /= nf90_noerr) call handle_err(status)
-  
-! Define variables in the file.
-
-    status = nf90_def_var(ncid, "time", NF90_DOUBLE, dim_id_time, varid)
-      status = nf90_put_att(ncid, varid, "long_name", "time")
-      status = nf90_put_att(ncid, varid, "units", "seconds since "//reference_date)
-
-    status = nf90_def_var(ncid, "delt", NF90_FLOAT, (/dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "time step")
-      status = nf90_put_att(ncid, varid, "units", "seconds")
-
-    status = nf90_def_var(ncid, "ps", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface pressure")
-      status = nf90_put_att(ncid, varid, "units", "Pa")
-
-    status = nf90_def_var(ncid, "t1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "q1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing specific humidity")
-      status = nf90_put_att(ncid, varid, "units", "kg/kg")
-
-    status = nf90_def_var(ncid, "sigmaf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "green vegetation fraction")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "sfcemis", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface emissivity")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "dlwflx", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing longwave downward flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "dswsfc", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing shortwave downward flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "snet", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing net shortwave flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "tg3", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "deep soil temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "cm", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface exchange coeff for lndentum")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "ch", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface exchange coeff heat & moisture")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "prsl1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "sfc layer 1 mean pressure")
-      status = nf90_put_att(ncid, varid, "units", "Pa")
-
-    status = nf90_def_var(ncid, "prslki", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "Exner function from layer 1 to sfc")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "zf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "height of bottom layer")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "wind", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "wind speed")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
- 
-    status = nf90_def_var(ncid, "shdmin", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "min fractional coverage of green veg")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "shdmax", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "max fractional coverage of green veg")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "snoalb", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "upper bound on max albedo over deep snow")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "sfalb", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "mean sfc diffuse sw albedo")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "weasd", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "water equivalent accumulated snow depth")
-      status = nf90_put_att(ncid, varid, "units", "mm")
-
-    status = nf90_def_var(ncid, "snwdph", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow depth (water equiv) over land")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "tskin", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "ground surface skin temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "tprcp", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total precipitation")
-      status = nf90_put_att(ncid, varid, "units", "mm")
-
-    status = nf90_def_var(ncid, "srflag", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow/rain flag for precipitation")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "smc", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total soil moisture content")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "stc", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "soil temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "slc", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "liquid soil moisture")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "canopy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "canopy moisture content")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "trans", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total plant transpiration")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "tsurf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface skin temperature (after iteration)")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "zorl", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface roughness")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "sncovr1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow cover over land")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "qsurf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "specific humidity at sfc")
-      status = nf90_put_att(ncid, varid, "units", "kg/kg")
-
-    status = nf90_def_var(ncid, "gflux", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "soil heat flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "drain", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "subsurface runoff")
-      status = nf90_put_att(ncid, varid, "units", "mm/s")
-
-    status = nf90_def_var(ncid, "evap", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "evaporation from latent heat flux")
-      status = nf90_put_att(ncid, varid, "units", "mm/s")
-
-    status = nf90_def_var(ncid, "hflx", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "sensible heat flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "ep", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "potential evaporation")
-      status = nf90_put_att(ncid, varid, "units", "?")
-
-    status = nf90_def_var(ncid, "runoff", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface runoff")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "cmm", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "ch * rho")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "chh", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "evbs", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "direct soil evaporation")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "evcw", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "canopy water evaporation")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "sbsno", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "sublimation/deposit from snopack")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "snowc", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "fractional snow cover")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "stm", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total soil column moisture content")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "snohf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow/freezing-rain latent heat flux ")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "smcwlt2", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "dry soil moisture threshold")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "smcref2", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "soil moisture threshold")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "wet1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "normalized soil wetness")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_enddef(ncid)
-
-    status = nf90_close(ncid)
-    
-    this%output_counter = 1
+    call this%writer%Create(this%filename, reference_date, noah%static%im,            &
+                            namelist%begsub - namelist%begloc + 1, noah%static%im,   &
+                            namelist%output_buffer_steps, namelist%output_deflate_level, &
+                            namelist%output_async, namelist%output_sync_steps)
+
+    call this%writer%DefineDim("soil_levels", noah%static%km)
+
+    call this%writer%DefineVar("delt"   , "time step", "seconds", time_only = .true.)
+    call this%writer%DefineVar("ps"     , "surface pressure", "Pa")
+    call this%writer%DefineVar("t1"     , "forcing temperature", "K")
+    call this%writer%DefineVar("q1"     , "forcing specific humidity", "kg/kg")
+    call this%writer%DefineVar("sigmaf" , "green vegetation fraction", "-")
+    call this%writer%DefineVar("sfcemis", "surface emissivity", "-")
+    call this%writer%DefineVar("dlwflx" , "forcing longwave downward flux", "W/m2")
+    call this%writer%DefineVar("dswsfc" , "forcing shortwave downward flux", "W/m2")
+    call this%writer%DefineVar("snet"   , "forcing net shortwave flux", "W/m2")
+    call this%writer%DefineVar("tg3"    , "deep soil temperature", "K")
+    call this%writer%DefineVar("cm"     , "surface exchange coeff for lndentum", "m/s")
+    call this%writer%DefineVar("ch"     , "surface exchange coeff heat & moisture", "m/s")
+    call this%writer%DefineVar("prsl1"  , "sfc layer 1 mean pressure", "Pa")
+    call this%writer%DefineVar("prslki" , "Exner function from layer 1 to sfc", "-")
+    call this%writer%DefineVar("zf"     , "height of bottom layer", "m")
+    call this%writer%DefineVar("wind"   , "wind speed", "m/s")
+    call this%writer%DefineVar("shdmin" , "min fractional coverage of green veg", "fraction")
+    call this%writer%DefineVar("shdmax" , "max fractional coverage of green veg", "fraction")
+    call this%writer%DefineVar("snoalb" , "upper bound on max albedo over deep snow", "fraction")
+    call this%writer%DefineVar("sfalb"  , "mean sfc diffuse sw albedo", "fraction")
+    call this%writer%DefineVar("weasd"  , "water equivalent accumulated snow depth", "mm")
+    call this%writer%DefineVar("snwdph" , "snow depth (water equiv) over land", "m")
+    call this%writer%DefineVar("tskin"  , "ground surface skin temperature", "K")
+    call this%writer%DefineVar("tprcp"  , "total precipitation", "mm")
+    call this%writer%DefineVar("srflag" , "snow/rain flag for precipitation", "fraction")
+    call this%writer%DefineVar("smc"    , "total soil moisture content", "m3/m3", levels = "soil_levels")
+    call this%writer%DefineVar("stc"    , "soil temperature", "K", levels = "soil_levels")
+    call this%writer%DefineVar("slc"    , "liquid soil moisture", "m3/m3", levels = "soil_levels")
+    call this%writer%DefineVar("canopy" , "canopy moisture content", "m")
+    call this%writer%DefineVar("trans"  , "total plant transpiration", "m/s")
+    call this%writer%DefineVar("tsurf"  , "surface skin temperature (after iteration)", "K")
+    call this%writer%DefineVar("zorl"   , "surface roughness", "m")
+    call this%writer%DefineVar("sncovr1", "snow cover over land", "fraction")
+    call this%writer%DefineVar("qsurf"  , "specific humidity at sfc", "kg/kg")
+    call this%writer%DefineVar("gflux"  , "soil heat flux", "W/m2")
+    call this%writer%DefineVar("drain"  , "subsurface runoff", "mm/s")
+    call this%writer%DefineVar("evap"   , "evaporation from latent heat flux", "mm/s")
+    call this%writer%DefineVar("hflx"   , "sensible heat flux", "W/m2")
+    call this%writer%DefineVar("ep"     , "potential evaporation", "?")
+    call this%writer%DefineVar("runoff" , "surface runoff", "m/s")
+    call this%writer%DefineVar("cmm"    , "ch * rho", "")
+    call this%writer%DefineVar("chh"    , "", "m/s")
+    call this%writer%DefineVar("evbs"   , "direct soil evaporation", "m/s")
+    call this%writer%DefineVar("evcw"   , "canopy water evaporation", "m/s")
+    call this%writer%DefineVar("sbsno"  , "sublimation/deposit from snopack", "m/s")
+    call this%writer%DefineVar("snowc"  , "fractional snow cover", "fraction")
+    call this%writer%DefineVar("stm"    , "total soil column moisture content", "m")
+    call this%writer%DefineVar("snohf"  , "snow/freezing-rain latent heat flux ", "W/m2")
+    call this%writer%DefineVar("smcwlt2", "dry soil moisture threshold", "m3/m3")
+    call this%writer%DefineVar("smcref2", "soil moisture threshold", "m3/m3")
+    call this%writer%DefineVar("wet1"   , "normalized soil wetness", "-")
+
+    call this%writer%EndDefine()
 
   end if
   
-  outsub = namelist%begsub - namelist%begloc + 1
-  
-  status = nf90_open(this%filename, NF90_WRITE, ncid)
-   if (status /= nf90_noerr) call handle_err(status)
-  
-  status = nf90_inq_varid(ncid, "time", varid)
-  status = nf90_put_var(ncid, varid , now_time           , start = (/this%output_counter/))
-  
-  status = nf90_inq_varid(ncid, "delt", varid)
-  status = nf90_put_var(ncid, varid , noah%static%delt   , start = (/this%output_counter/))
-
-  status = nf90_inq_varid(ncid, "ps", varid)
-  status = nf90_put_var(ncid, varid , forcing%surface_pressure   , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "t1", varid)
-  status = nf90_put_var(ncid, varid , forcing%temperature        , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "q1", varid)
-  status = nf90_put_var(ncid, varid , forcing%specific_humidity  , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "wind", varid)
-  status = nf90_put_var(ncid, varid , forcing%wind_speed         , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tprcp", varid)
-  status = nf90_put_var(ncid, varid , forcing%precipitation      , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "dlwflx", varid)
-  status = nf90_put_var(ncid, varid , forcing%downward_longwave  , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "dswsfc", varid)
-  status = nf90_put_var(ncid, varid , forcing%downward_shortwave , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sigmaf", varid)
-  status = nf90_put_var(ncid, varid , noah%model%sigmaf          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sfcemis", varid)
-  status = nf90_put_var(ncid, varid , noah%model%sfcemis         , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snet", varid)
-  status = nf90_put_var(ncid, varid , noah%model%snet            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tg3", varid)
-  status = nf90_put_var(ncid, varid , noah%model%tg3             , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "cm", varid)
-  status = nf90_put_var(ncid, varid , noah%model%cm              , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "ch", varid)
-  status = nf90_put_var(ncid, varid , noah%model%ch              , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "prsl1", varid)
-  status = nf90_put_var(ncid, varid , noah%model%prsl1           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "prslki", varid)
-  status = nf90_put_var(ncid, varid , noah%model%prslki          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "zf", varid)
-  status = nf90_put_var(ncid, varid , noah%model%zf              , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "shdmin", varid)
-  status = nf90_put_var(ncid, varid , noah%model%shdmin          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "shdmax", varid)
-  status = nf90_put_var(ncid, varid , noah%model%shdmax          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snoalb", varid)
-  status = nf90_put_var(ncid, varid , noah%model%snoalb          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sfalb", varid)
-  status = nf90_put_var(ncid, varid , noah%model%sfalb           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "weasd", varid)
-  status = nf90_put_var(ncid, varid , noah%model%weasd           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snwdph", varid)
-  status = nf90_put_var(ncid, varid , noah%model%snwdph          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tskin", varid)
-  status = nf90_put_var(ncid, varid , noah%model%tskin           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "srflag", varid)
-  status = nf90_put_var(ncid, varid , noah%model%srflag          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smc", varid)
-  status = nf90_put_var(ncid, varid , noah%model%smc                , &
-      start = (/        outsub,              1,this%output_counter/), &
-      count = (/noah%static%im, noah%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "stc", varid)
-  status = nf90_put_var(ncid, varid , noah%model%stc                , &
-      start = (/        outsub,              1,this%output_counter/), &
-      count = (/noah%static%im, noah%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "slc", varid)
-  status = nf90_put_var(ncid, varid , noah%model%slc                , &
-      start = (/        outsub,              1,this%output_counter/), &
-      count = (/noah%static%im, noah%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "canopy", varid)
-  status = nf90_put_var(ncid, varid , noah%model%canopy          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "trans", varid)
-  status = nf90_put_var(ncid, varid , noah%model%trans           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tsurf", varid)
-  status = nf90_put_var(ncid, varid , noah%model%tsurf           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "zorl", varid)
-  status = nf90_put_var(ncid, varid , noah%model%zorl            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sncovr1", varid)
-  status = nf90_put_var(ncid, varid , noah%model%sncovr1         , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "qsurf", varid)
-  status = nf90_put_var(ncid, varid , noah%model%qsurf           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "gflux", varid)
-  status = nf90_put_var(ncid, varid , noah%model%gflux           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "drain", varid)
-  status = nf90_put_var(ncid, varid , noah%model%drain           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "evap", varid)
-  status = nf90_put_var(ncid, varid , noah%model%evap            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "hflx", varid)
-  status = nf90_put_var(ncid, varid , noah%model%hflx            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "ep", varid)
-  status = nf90_put_var(ncid, varid , noah%model%ep              , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "runoff", varid)
-  status = nf90_put_var(ncid, varid , noah%model%runoff          , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "cmm", varid)
-  status = nf90_put_var(ncid, varid , noah%model%cmm             , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "chh", varid)
-  status = nf90_put_var(ncid, varid , noah%model%chh             , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "evbs", varid)
-  status = nf90_put_var(ncid, varid , noah%model%evbs            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "evcw", varid)
-  status = nf90_put_var(ncid, varid , noah%model%evcw            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sbsno", varid)
-  status = nf90_put_var(ncid, varid , noah%model%sbsno           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snowc", varid)
-  status = nf90_put_var(ncid, varid , noah%model%snowc           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "stm", varid)
-  status = nf90_put_var(ncid, varid , noah%model%stm             , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snohf", varid)
-  status = nf90_put_var(ncid, varid , noah%model%snohf           , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smcwlt2", varid)
-  status = nf90_put_var(ncid, varid , noah%model%smcwlt2         , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smcref2", varid)
-  status = nf90_put_var(ncid, varid , noah%model%smcref2         , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "wet1", varid)
-  status = nf90_put_var(ncid, varid , noah%model%wet1            , &
-      start = (/outsub,this%output_counter/), count = (/noah%static%im, 1/))
-
-  
-  status = nf90_close(ncid)
-
-  this%output_counter = this%output_counter + 1
+  call this%writer%Put("delt"   , noah%static%delt)
+  call this%writer%Put("ps"     , forcing%surface_pressure)
+  call this%writer%Put("t1"     , forcing%temperature)
+  call this%writer%Put("q1"     , forcing%specific_humidity)
+  call this%writer%Put("wind"   , forcing%wind_speed)
+  call this%writer%Put("tprcp"  , forcing%precipitation)
+  call this%writer%Put("dlwflx" , forcing%downward_longwave)
+  call this%writer%Put("dswsfc" , forcing%downward_shortwave)
+  call this%writer%Put("sigmaf" , noah%model%sigmaf)
+  call this%writer%Put("sfcemis", noah%model%sfcemis)
+  call this%writer%Put("snet"   , noah%model%snet)
+  call this%writer%Put("tg3"    , noah%model%tg3)
+  call this%writer%Put("cm"     , noah%model%cm)
+  call this%writer%Put("ch"     , noah%model%ch)
+  call this%writer%Put("prsl1"  , noah%model%prsl1)
+  call this%writer%Put("prslki" , noah%model%prslki)
+  call this%writer%Put("zf"     , noah%model%zf)
+  call this%writer%Put("shdmin" , noah%model%shdmin)
+  call this%writer%Put("shdmax" , noah%model%shdmax)
+  call this%writer%Put("snoalb" , noah%model%snoalb)
+  call this%writer%Put("sfalb"  , noah%model%sfalb)
+  call this%writer%Put("weasd"  , noah%model%weasd)
+  call this%writer%Put("snwdph" , noah%model%snwdph)
+  call this%writer%Put("tskin"  , noah%model%tskin)
+  call this%writer%Put("srflag" , noah%model%srflag)
+  call this%writer%Put("smc"    , noah%model%smc)
+  call this%writer%Put("stc"    , noah%model%stc)
+  call this%writer%Put("slc"    , noah%model%slc)
+  call this%writer%Put("canopy" , noah%model%canopy)
+  call this%writer%Put("trans"  , noah%model%trans)
+  call this%writer%Put("tsurf"  , noah%model%tsurf)
+  call this%writer%Put("zorl"   , noah%model%zorl)
+  call this%writer%Put("sncovr1", noah%model%sncovr1)
+  call this%writer%Put("qsurf"  , noah%model%qsurf)
+  call this%writer%Put("gflux"  , noah%model%gflux)
+  call this%writer%Put("drain"  , noah%model%drain)
+  call this%writer%Put("evap"   , noah%model%evap)
+  call this%writer%Put("hflx"   , noah%model%hflx)
+  call this%writer%Put("ep"     , noah%model%ep)
+  call this%writer%Put("runoff" , noah%model%runoff)
+  call this%writer%Put("cmm"    , noah%model%cmm)
+  call this%writer%Put("chh"    , noah%model%chh)
+  call this%writer%Put("evbs"   , noah%model%evbs)
+  call this%writer%Put("evcw"   , noah%model%evcw)
+  call this%writer%Put("sbsno"  , noah%model%sbsno)
+  call this%writer%Put("snowc"  , noah%model%snowc)
+  call this%writer%Put("stm"    , noah%model%stm)
+  call this%writer%Put("snohf"  , noah%model%snohf)
+  call this%writer%Put("smcwlt2", noah%model%smcwlt2)
+  call this%writer%Put("smcref2", noah%model%smcref2)
+  call this%writer%Put("wet1"   , noah%model%wet1)
+
+  call this%writer%Advance(now_time)
   
   end subroutine WriteOutputNoah
   
   subroutine WriteOutputNoahMP(this, namelist, noahmp, forcing, now_time)
   
-  use netcdf
   use time_utilities
-  use error_handling, only : handle_err
   use NamelistRead
   use ufsLandNoahMPType
   use ufsLandForcingModule
@@ -525,12 +187,9 @@ contains
   character*19     :: nowdate    ! current date
   character*19     :: reference_date = "1970-01-01 00:00:00"
   integer          :: yyyy,mm,dd,hh,nn,ss
-  integer :: ncid, dimid, varid, status
-  integer :: dim_id_time, dim_id_loc, dim_id_soil, dim_id_snow, dim_id_snso, dim_id_date
-  integer :: outsub
   
   if(now_time == namelist%initial_time + namelist%timestep_seconds .or. &
-     namelist%separate_output ) then
+     namelist%separate_output) then
   
     call date_from_since(reference_date, now_time, nowdate)
     read(nowdate( 1: 4),'(i4.4)') yyyy
@@ -545,795 +204,222 @@ contains
 
     this%filename = trim(namelist%output_dir)//"/"//trim(this%filename)
 
-    write(*,*) "Creating: "//trim(this%filename)
-
-    status = nf90_create(this%filename, NF90_CLOBBER, ncid)
-      if (status /= nf90_noerr) call handle_err(status)
-
-! Define dimensions in the file.
-
-    status = nf90_def_dim(ncid, "location"    , noahmp%static%im     , dim_id_loc)
-      if (status /= nf90_noerr) call handle_err(status)
-    status = nf90_def_dim(ncid, "soil_levels" , noahmp%static%km     , dim_id_soil)
-      if (status /= nf90_noerr) call handle_err(status)
-    status = nf90_def_dim(ncid, "snow_levels" , 3                    , dim_id_snow)
-      if (status /= nf90_noerr) call handle_err(status)
-    status = nf90_def_dim(ncid, "snso_levels" , noahmp%static%km + 3 , dim_id_snso)
-      if (status /= nf90_noerr) call handle_err(status)
-    status = nf90_def_dim(ncid, "time"        , NF90_UNLIMITED       , dim_id_time)
-      if (status /= nf90_noerr) call handle_err(status)
-  
-! Define variables in the file.
-
-    status = nf90_def_var(ncid, "time", NF90_DOUBLE, dim_id_time, varid)
-      status = nf90_put_att(ncid, varid, "long_name", "time")
-      status = nf90_put_att(ncid, varid, "units", "seconds since "//reference_date)
-
-    status = nf90_def_var(ncid, "delt", NF90_FLOAT, (/dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "time step")
-      status = nf90_put_att(ncid, varid, "units", "seconds")
-
-    status = nf90_def_var(ncid, "ps", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface pressure")
-      status = nf90_put_att(ncid, varid, "units", "Pa")
-
-    status = nf90_def_var(ncid, "t1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "q1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing specific humidity")
-      status = nf90_put_att(ncid, varid, "units", "kg/kg")
-
-    status = nf90_def_var(ncid, "sigmaf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "green vegetation fraction")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "emiss", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface emissivity")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "albdvis", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface albedo - direct visible")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "albdnir", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface albedo - direct NIR")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "albivis", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface albedo - diffuse visible")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "albinir", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface albedo - diffuse NIR")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "dlwflx", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing longwave downward flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "dswsfc", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing shortwave downward flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "snet", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "forcing net shortwave flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "tg3", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "deep soil temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "cm", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface exchange coeff for lndentum")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "ch", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface exchange coeff heat & moisture")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "prsl1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "sfc layer 1 mean pressure")
-      status = nf90_put_att(ncid, varid, "units", "Pa")
-
-    status = nf90_def_var(ncid, "prslki", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "Exner function from layer 1 to sfc")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "zf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "height of bottom layer")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "wind", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "wind speed")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
- 
-    status = nf90_def_var(ncid, "shdmin", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "min fractional coverage of green veg")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "shdmax", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "max fractional coverage of green veg")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "snoalb", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "upper bound on max albedo over deep snow")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "sfalb", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "mean sfc diffuse sw albedo")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "weasd", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "water equivalent accumulated snow depth")
-      status = nf90_put_att(ncid, varid, "units", "mm")
-
-    status = nf90_def_var(ncid, "snwdph", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow depth (water equiv) over land")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "tskin", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "ground surface skin temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "tprcp", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total precipitation")
-      status = nf90_put_att(ncid, varid, "units", "mm")
-
-    status = nf90_def_var(ncid, "srflag", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow/rain flag for precipitation")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "smc", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total soil moisture content")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "stc", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "soil temperature")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "slc", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "liquid soil moisture")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "canopy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "canopy moisture content")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "trans", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total plant transpiration")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "tsurf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface skin temperature (after iteration)")
-      status = nf90_put_att(ncid, varid, "units", "K")
-
-    status = nf90_def_var(ncid, "zorl", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface roughness")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "sncovr1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow cover over land")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "qsurf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "specific humidity at sfc")
-      status = nf90_put_att(ncid, varid, "units", "kg/kg")
-
-    status = nf90_def_var(ncid, "gflux", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "soil heat flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "drain", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "subsurface runoff")
-      status = nf90_put_att(ncid, varid, "units", "mm/s")
-
-    status = nf90_def_var(ncid, "evap", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "evaporation from latent heat flux")
-      status = nf90_put_att(ncid, varid, "units", "mm/s")
-
-    status = nf90_def_var(ncid, "hflx", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "sensible heat flux")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "ep", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "potential evaporation")
-      status = nf90_put_att(ncid, varid, "units", "?")
-
-    status = nf90_def_var(ncid, "runoff", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "surface runoff")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "cmm", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "ch * rho")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "chh", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "evbs", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "direct soil evaporation")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "evcw", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "canopy water evaporation")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "sbsno", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "sublimation/deposit from snopack")
-      status = nf90_put_att(ncid, varid, "units", "m/s")
-
-    status = nf90_def_var(ncid, "snowc", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "fractional snow cover")
-      status = nf90_put_att(ncid, varid, "units", "fraction")
-
-    status = nf90_def_var(ncid, "stm", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "total soil column moisture content")
-      status = nf90_put_att(ncid, varid, "units", "m")
-
-    status = nf90_def_var(ncid, "snohf", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "snow/freezing-rain latent heat flux ")
-      status = nf90_put_att(ncid, varid, "units", "W/m2")
-
-    status = nf90_def_var(ncid, "smcwlt2", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "dry soil moisture threshold")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "smcref2", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "soil moisture threshold")
-      status = nf90_put_att(ncid, varid, "units", "m3/m3")
-
-    status = nf90_def_var(ncid, "wet1", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "normalized soil wetness")
-      status = nf90_put_att(ncid, varid, "units", "-")
-
-    status = nf90_def_var(ncid, "xcoszin", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "snowxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "tvxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "tgxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "canicexy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "canliqxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "eahxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "tahxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "cmxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "chxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "fwetxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "sneqvoxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "alboldxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "qsnowxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "wslakexy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "zwtxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "waxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "wtxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "lfmassxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "rtmassxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "stmassxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "woodxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "stblcpxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "fastcpxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "xlaixy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "xsaixy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "taussxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "smcwtdxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "deeprechxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "rechxy", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "t2mmp", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "q2mp", NF90_FLOAT, (/dim_id_loc,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "smoiseq", NF90_FLOAT, (/dim_id_loc,dim_id_soil,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "tsnoxy", NF90_FLOAT, (/dim_id_loc,dim_id_snow,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "zsnsoxy", NF90_FLOAT, (/dim_id_loc,dim_id_snso,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "snicexy", NF90_FLOAT, (/dim_id_loc,dim_id_snow,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_def_var(ncid, "snliqxy", NF90_FLOAT, (/dim_id_loc,dim_id_snow,dim_id_time/), varid)
-      status = nf90_put_att(ncid, varid, "long_name", "")
-      status = nf90_put_att(ncid, varid, "units", "")
-
-    status = nf90_enddef(ncid)
-
-    status = nf90_close(ncid)
-    
-    this%output_counter = 1
+! The file holds all the locations, the processes send their part to the
+! first process when the writer is flushed
+
+    call this%writer%Create(this%filename, reference_date,                          &
+                            namelist%endloc - namelist%begloc + 1,                  &
+                            namelist%begsub - namelist%begloc + 1, noahmp%static%im, &
+                            namelist%output_buffer_steps, namelist%output_deflate_level, &
+                            namelist%output_async, namelist%output_sync_steps)
+
+    call this%writer%DefineDim("soil_levels", noahmp%static%km)
+    call this%writer%DefineDim("snow_levels", 3)
+    call this%writer%DefineDim("snso_levels", noahmp%static%km + 3)
+
+    call this%writer%DefineVar("delt"      , "time step", "seconds", time_only = .true.)
+    call this%writer%DefineVar("ps"        , "surface pressure", "Pa")
+    call this%writer%DefineVar("t1"        , "forcing temperature", "K")
+    call this%writer%DefineVar("q1"        , "forcing specific humidity", "kg/kg")
+    call this%writer%DefineVar("sigmaf"    , "green vegetation fraction", "-")
+    call this%writer%DefineVar("emiss"     , "surface emissivity", "-")
+    call this%writer%DefineVar("albdvis"   , "surface albedo - direct visible", "-")
+    call this%writer%DefineVar("albdnir"   , "surface albedo - direct NIR", "-")
+    call this%writer%DefineVar("albivis"   , "surface albedo - diffuse visible", "-")
+    call this%writer%DefineVar("albinir"   , "surface albedo - diffuse NIR", "-")
+    call this%writer%DefineVar("dlwflx"    , "forcing longwave downward flux", "W/m2")
+    call this%writer%DefineVar("dswsfc"    , "forcing shortwave downward flux", "W/m2")
+    call this%writer%DefineVar("snet"      , "forcing net shortwave flux", "W/m2")
+    call this%writer%DefineVar("tg3"       , "deep soil temperature", "K")
+    call this%writer%DefineVar("cm"        , "surface exchange coeff for lndentum", "m/s")
+    call this%writer%DefineVar("ch"        , "surface exchange coeff heat & moisture", "m/s")
+    call this%writer%DefineVar("prsl1"     , "sfc layer 1 mean pressure", "Pa")
+    call this%writer%DefineVar("prslki"    , "Exner function from layer 1 to sfc", "-")
+    call this%writer%DefineVar("zf"        , "height of bottom layer", "m")
+    call this%writer%DefineVar("wind"      , "wind speed", "m/s")
+    call this%writer%DefineVar("shdmin"    , "min fractional coverage of green veg", "fraction")
+    call this%writer%DefineVar("shdmax"    , "max fractional coverage of green veg", "fraction")
+    call this%writer%DefineVar("snoalb"    , "upper bound on max albedo over deep snow", "fraction")
+    call this%writer%DefineVar("sfalb"     , "mean sfc diffuse sw albedo", "fraction")
+    call this%writer%DefineVar("weasd"     , "water equivalent accumulated snow depth", "mm")
+    call this%writer%DefineVar("snwdph"    , "snow depth (water equiv) over land", "m")
+    call this%writer%DefineVar("tskin"     , "ground surface skin temperature", "K")
+    call this%writer%DefineVar("tprcp"     , "total precipitation", "mm")
+    call this%writer%DefineVar("srflag"    , "snow/rain flag for precipitation", "fraction")
+    call this%writer%DefineVar("smc"       , "total soil moisture content", "m3/m3", levels = "soil_levels")
+    call this%writer%DefineVar("stc"       , "soil temperature", "K", levels = "soil_levels")
+    call this%writer%DefineVar("slc"       , "liquid soil moisture", "m3/m3", levels = "soil_levels")
+    call this%writer%DefineVar("canopy"    , "canopy moisture content", "m")
+    call this%writer%DefineVar("trans"     , "total plant transpiration", "m/s")
+    call this%writer%DefineVar("tsurf"     , "surface skin temperature (after iteration)", "K")
+    call this%writer%DefineVar("zorl"      , "surface roughness", "m")
+    call this%writer%DefineVar("sncovr1"   , "snow cover over land", "fraction")
+    call this%writer%DefineVar("qsurf"     , "specific humidity at sfc", "kg/kg")
+    call this%writer%DefineVar("gflux"     , "soil heat flux", "W/m2")
+    call this%writer%DefineVar("drain"     , "subsurface runoff", "mm/s")
+    call this%writer%DefineVar("evap"      , "evaporation from latent heat flux", "mm/s")
+    call this%writer%DefineVar("hflx"      , "sensible heat flux", "W/m2")
+    call this%writer%DefineVar("ep"        , "potential evaporation", "?")
+    call this%writer%DefineVar("runoff"    , "surface runoff", "m/s")
+    call this%writer%DefineVar("cmm"       , "ch * rho", "")
+    call this%writer%DefineVar("chh"       , "", "m/s")
+    call this%writer%DefineVar("evbs"      , "direct soil evaporation", "m/s")
+    call this%writer%DefineVar("evcw"      , "canopy water evaporation", "m/s")
+    call this%writer%DefineVar("sbsno"     , "sublimation/deposit from snopack", "m/s")
+    call this%writer%DefineVar("snowc"     , "fractional snow cover", "fraction")
+    call this%writer%DefineVar("stm"       , "total soil column moisture content", "m")
+    call this%writer%DefineVar("snohf"     , "snow/freezing-rain latent heat flux ", "W/m2")
+    call this%writer%DefineVar("smcwlt2"   , "dry soil moisture threshold", "m3/m3")
+    call this%writer%DefineVar("smcref2"   , "soil moisture threshold", "m3/m3")
+    call this%writer%DefineVar("wet1"      , "normalized soil wetness", "-")
+    call this%writer%DefineVar("xcoszin"   , "", "")
+    call this%writer%DefineVar("snowxy"    , "", "")
+    call this%writer%DefineVar("tvxy"      , "", "")
+    call this%writer%DefineVar("tgxy"      , "", "")
+    call this%writer%DefineVar("canicexy"  , "", "")
+    call this%writer%DefineVar("canliqxy"  , "", "")
+    call this%writer%DefineVar("eahxy"     , "", "")
+    call this%writer%DefineVar("tahxy"     , "", "")
+    call this%writer%DefineVar("cmxy"      , "", "")
+    call this%writer%DefineVar("chxy"      , "", "")
+    call this%writer%DefineVar("fwetxy"    , "", "")
+    call this%writer%DefineVar("sneqvoxy"  , "", "")
+    call this%writer%DefineVar("alboldxy"  , "", "")
+    call this%writer%DefineVar("qsnowxy"   , "", "")
+    call this%writer%DefineVar("wslakexy"  , "", "")
+    call this%writer%DefineVar("zwtxy"     , "", "")
+    call this%writer%DefineVar("waxy"      , "", "")
+    call this%writer%DefineVar("wtxy"      , "", "")
+    call this%writer%DefineVar("lfmassxy"  , "", "")
+    call this%writer%DefineVar("rtmassxy"  , "", "")
+    call this%writer%DefineVar("stmassxy"  , "", "")
+    call this%writer%DefineVar("woodxy"    , "", "")
+    call this%writer%DefineVar("stblcpxy"  , "", "")
+    call this%writer%DefineVar("fastcpxy"  , "", "")
+    call this%writer%DefineVar("xlaixy"    , "", "")
+    call this%writer%DefineVar("xsaixy"    , "", "")
+    call this%writer%DefineVar("taussxy"   , "", "")
+    call this%writer%DefineVar("smcwtdxy"  , "", "")
+    call this%writer%DefineVar("deeprechxy", "", "")
+    call this%writer%DefineVar("rechxy"    , "", "")
+    call this%writer%DefineVar("t2mmp"     , "", "")
+    call this%writer%DefineVar("q2mp"      , "", "")
+    call this%writer%DefineVar("smoiseq"   , "", "", levels = "soil_levels")
+    call this%writer%DefineVar("tsnoxy"    , "", "", levels = "snow_levels")
+    call this%writer%DefineVar("zsnsoxy"   , "", "", levels = "snso_levels")
+    call this%writer%DefineVar("snicexy"   , "", "", levels = "snow_levels")
+    call this%writer%DefineVar("snliqxy"   , "", "", levels = "snow_levels")
+
+    call this%writer%EndDefine()
 
   end if
   
-  outsub = namelist%begsub - namelist%begloc + 1
+  call this%writer%Put("delt"      , noahmp%static%delt)
+  call this%writer%Put("ps"        , forcing%surface_pressure)
+  call this%writer%Put("t1"        , forcing%temperature)
+  call this%writer%Put("q1"        , forcing%specific_humidity)
+  call this%writer%Put("wind"      , forcing%wind_speed)
+  call this%writer%Put("tprcp"     , forcing%precipitation)
+  call this%writer%Put("dlwflx"    , forcing%downward_longwave)
+  call this%writer%Put("dswsfc"    , forcing%downward_shortwave)
+  call this%writer%Put("sigmaf"    , noahmp%model%sigmaf)
+  call this%writer%Put("emiss"     , noahmp%model%emiss)
+  call this%writer%Put("albdvis"   , noahmp%model%albdvis)
+  call this%writer%Put("albdnir"   , noahmp%model%albdnir)
+  call this%writer%Put("albivis"   , noahmp%model%albivis)
+  call this%writer%Put("albinir"   , noahmp%model%albinir)
+  call this%writer%Put("snet"      , noahmp%model%snet)
+  call this%writer%Put("tg3"       , noahmp%model%tg3)
+  call this%writer%Put("cm"        , noahmp%model%cm)
+  call this%writer%Put("ch"        , noahmp%model%ch)
+  call this%writer%Put("prsl1"     , noahmp%model%prsl1)
+  call this%writer%Put("prslki"    , noahmp%model%prslki)
+  call this%writer%Put("zf"        , noahmp%model%zf)
+  call this%writer%Put("shdmin"    , noahmp%model%shdmin)
+  call this%writer%Put("shdmax"    , noahmp%model%shdmax)
+  call this%writer%Put("snoalb"    , noahmp%model%snoalb)
+  call this%writer%Put("sfalb"     , noahmp%model%sfalb)
+  call this%writer%Put("weasd"     , noahmp%model%weasd)
+  call this%writer%Put("snwdph"    , noahmp%model%snwdph)
+  call this%writer%Put("tskin"     , noahmp%model%tskin)
+  call this%writer%Put("srflag"    , noahmp%model%srflag)
+  call this%writer%Put("smc"       , noahmp%model%smc)
+  call this%writer%Put("stc"       , noahmp%model%stc)
+  call this%writer%Put("slc"       , noahmp%model%slc)
+  call this%writer%Put("canopy"    , noahmp%model%canopy)
+  call this%writer%Put("trans"     , noahmp%model%trans)
+  call this%writer%Put("tsurf"     , noahmp%model%tsurf)
+  call this%writer%Put("zorl"      , noahmp%model%zorl)
+  call this%writer%Put("sncovr1"   , noahmp%model%sncovr1)
+  call this%writer%Put("qsurf"     , noahmp%model%qsurf)
+  call this%writer%Put("gflux"     , noahmp%model%gflux)
+  call this%writer%Put("drain"     , noahmp%model%drain)
+  call this%writer%Put("evap"      , noahmp%model%evap)
+  call this%writer%Put("hflx"      , noahmp%model%hflx)
+  call this%writer%Put("ep"        , noahmp%model%ep)
+  call this%writer%Put("runoff"    , noahmp%model%runoff)
+  call this%writer%Put("cmm"       , noahmp%model%cmm)
+  call this%writer%Put("chh"       , noahmp%model%chh)
+  call this%writer%Put("evbs"      , noahmp%model%evbs)
+  call this%writer%Put("evcw"      , noahmp%model%evcw)
+  call this%writer%Put("sbsno"     , noahmp%model%sbsno)
+  call this%writer%Put("snowc"     , noahmp%model%snowc)
+  call this%writer%Put("stm"       , noahmp%model%stm)
+  call this%writer%Put("snohf"     , noahmp%model%snohf)
+  call this%writer%Put("smcwlt2"   , noahmp%model%smcwlt2)
+  call this%writer%Put("smcref2"   , noahmp%model%smcref2)
+  call this%writer%Put("wet1"      , noahmp%model%wet1)
+  call this%writer%Put("xcoszin"   , noahmp%model%xcoszin)
+  call this%writer%Put("snowxy"    , noahmp%model%snowxy)
+  call this%writer%Put("tvxy"      , noahmp%model%tvxy)
+  call this%writer%Put("tgxy"      , noahmp%model%tgxy)
+  call this%writer%Put("canicexy"  , noahmp%model%canicexy)
+  call this%writer%Put("canliqxy"  , noahmp%model%canliqxy)
+  call this%writer%Put("eahxy"     , noahmp%model%eahxy)
+  call this%writer%Put("tahxy"     , noahmp%model%tahxy)
+  call this%writer%Put("cmxy"      , noahmp%model%cmxy)
+  call this%writer%Put("chxy"      , noahmp%model%chxy)
+  call this%writer%Put("fwetxy"    , noahmp%model%fwetxy)
+  call this%writer%Put("sneqvoxy"  , noahmp%model%sneqvoxy)
+  call this%writer%Put("alboldxy"  , noahmp%model%alboldxy)
+  call this%writer%Put("qsnowxy"   , noahmp%model%qsnowxy)
+  call this%writer%Put("wslakexy"  , noahmp%model%wslakexy)
+  call this%writer%Put("zwtxy"     , noahmp%model%zwtxy)
+  call this%writer%Put("waxy"      , noahmp%model%waxy)
+  call this%writer%Put("wtxy"      , noahmp%model%wtxy)
+  call this%writer%Put("lfmassxy"  , noahmp%model%lfmassxy)
+  call this%writer%Put("rtmassxy"  , noahmp%model%rtmassxy)
+  call this%writer%Put("stmassxy"  , noahmp%model%stmassxy)
+  call this%writer%Put("woodxy"    , noahmp%model%woodxy)
+  call this%writer%Put("stblcpxy"  , noahmp%model%stblcpxy)
+  call this%writer%Put("fastcpxy"  , noahmp%model%fastcpxy)
+  call this%writer%Put("xlaixy"    , noahmp%model%xlaixy)
+  call this%writer%Put("xsaixy"    , noahmp%model%xsaixy)
+  call this%writer%Put("taussxy"   , noahmp%model%taussxy)
+  call this%writer%Put("smcwtdxy"  , noahmp%model%smcwtdxy)
+  call this%writer%Put("deeprechxy", noahmp%model%deeprechxy)
+  call this%writer%Put("rechxy"    , noahmp%model%rechxy)
+  call this%writer%Put("t2mmp"     , noahmp%model%t2mmp)
+  call this%writer%Put("q2mp"      , noahmp%model%q2mp)
+  call this%writer%Put("smoiseq"   , noahmp%model%smoiseq)
+  call this%writer%Put("zsnsoxy"   , noahmp%model%zsnsoxy)
+  call this%writer%Put("tsnoxy"    , noahmp%model%tsnoxy)
+  call this%writer%Put("snicexy"   , noahmp%model%snicexy)
+  call this%writer%Put("snliqxy"   , noahmp%model%snliqxy)
+
+  call this%writer%Advance(now_time)
   
-  status = nf90_open(this%filename, NF90_WRITE, ncid)
-   if (status /= nf90_noerr) call handle_err(status)
-  
-  status = nf90_inq_varid(ncid, "time", varid)
-  status = nf90_put_var(ncid, varid , now_time             , start = (/this%output_counter/))
+  end subroutine WriteOutputNoahMP
   
-  status = nf90_inq_varid(ncid, "delt", varid)
-  status = nf90_put_var(ncid, varid , noahmp%static%delt   , start = (/this%output_counter/))
-
-  status = nf90_inq_varid(ncid, "ps", varid)
-  status = nf90_put_var(ncid, varid , forcing%surface_pressure   , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "t1", varid)
-  status = nf90_put_var(ncid, varid , forcing%temperature        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-      
-  status = nf90_inq_varid(ncid, "q1", varid)
-  status = nf90_put_var(ncid, varid , forcing%specific_humidity  , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-      
-  status = nf90_inq_varid(ncid, "wind", varid)
-  status = nf90_put_var(ncid, varid , forcing%wind_speed         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-      
-  status = nf90_inq_varid(ncid, "tprcp", varid)
-  status = nf90_put_var(ncid, varid , forcing%precipitation      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-      
-  status = nf90_inq_varid(ncid, "dlwflx", varid)
-  status = nf90_put_var(ncid, varid , forcing%downward_longwave  , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-      
-  status = nf90_inq_varid(ncid, "dswsfc", varid)
-  status = nf90_put_var(ncid, varid , forcing%downward_shortwave , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-      
-  status = nf90_inq_varid(ncid, "sigmaf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sigmaf        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "emiss", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%emiss         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "albdvis", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albdvis       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "albdnir", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albdnir       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "albivis", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albivis       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "albinir", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albinir       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snet", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snet          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tg3", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tg3           , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "cm", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%cm            , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "ch", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%ch            , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "prsl1", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%prsl1         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
+! Write what is still buffered and close the file, at the end of the run
 
-  status = nf90_inq_varid(ncid, "prslki", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%prslki        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
+  subroutine CloseOutput(this)
 
-  status = nf90_inq_varid(ncid, "zf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zf            , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
+  class(output_type)   :: this
 
-  status = nf90_inq_varid(ncid, "shdmin", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%shdmin        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
+  call this%writer%Close()
 
-  status = nf90_inq_varid(ncid, "shdmax", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%shdmax        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snoalb", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snoalb        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sfalb", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sfalb         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "weasd", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%weasd         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snwdph", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snwdph        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tskin", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tskin         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "srflag", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%srflag        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smc                  , &
-      start = (/          outsub,                1,this%output_counter/), &
-      count = (/noahmp%static%im, noahmp%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "stc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stc                  , &
-      start = (/          outsub,                1,this%output_counter/), &
-      count = (/noahmp%static%im, noahmp%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "slc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%slc                  , &
-      start = (/          outsub,                1,this%output_counter/), &
-      count = (/noahmp%static%im, noahmp%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "canopy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%canopy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "trans", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%trans         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tsurf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tsurf         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "zorl", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zorl          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sncovr1", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sncovr1       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "qsurf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%qsurf         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "gflux", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%gflux         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "drain", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%drain         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "evap", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%evap          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "hflx", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%hflx          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "ep", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%ep            , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "runoff", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%runoff        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "cmm", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%cmm           , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "chh", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%chh           , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "evbs", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%evbs          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "evcw", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%evcw          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sbsno", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sbsno         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snowc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snowc         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "stm", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stm           , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snohf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snohf         , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smcwlt2", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smcwlt2       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smcref2", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smcref2       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "wet1", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%wet1          , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "xcoszin", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%xcoszin     , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "snowxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snowxy      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tvxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tvxy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tgxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tgxy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "canicexy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%canicexy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "canliqxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%canliqxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "eahxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%eahxy       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "tahxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tahxy       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "cmxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%cmxy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "chxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%chxy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "fwetxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%fwetxy      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "sneqvoxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sneqvoxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "alboldxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%alboldxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "qsnowxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%qsnowxy     , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "wslakexy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%wslakexy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "zwtxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zwtxy       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "waxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%waxy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "wtxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%wtxy        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "lfmassxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%lfmassxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "rtmassxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%rtmassxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "stmassxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stmassxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "woodxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%woodxy      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "stblcpxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stblcpxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "fastcpxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%fastcpxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "xlaixy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%xlaixy      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "xsaixy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%xsaixy      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "taussxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%taussxy     , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smcwtdxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smcwtdxy    , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "deeprechxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model% deeprechxy , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "rechxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%rechxy      , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "t2mmp", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%t2mmp       , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "q2mp", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%q2mp        , &
-      start = (/outsub,this%output_counter/), count = (/noahmp%static%im, 1/))
-
-  status = nf90_inq_varid(ncid, "smoiseq", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smoiseq              , &
-      start = (/outsub          ,                1,this%output_counter/), &
-      count = (/noahmp%static%im, noahmp%static%km,                  1/))
-
-  status = nf90_inq_varid(ncid, "zsnsoxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zsnsoxy                , &
-      start = (/outsub          ,                  1,this%output_counter/), &
-      count = (/noahmp%static%im, noahmp%static%km+3,                  1/))
-
-  status = nf90_inq_varid(ncid, "tsnoxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tsnoxy             , &
-      start = (/outsub          ,              1,this%output_counter/), &
-      count = (/noahmp%static%im,              3,                  1/))
-
-  status = nf90_inq_varid(ncid, "snicexy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snicexy            , &
-      start = (/outsub          ,              1,this%output_counter/), &
-      count = (/noahmp%static%im,              3,                  1/))
-
-  status = nf90_inq_varid(ncid, "snliqxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snliqxy            , &
-      start = (/outsub          ,              1,this%output_counter/), &
-      count = (/noahmp%static%im,              3,                  1/))
-
-  
-  status = nf90_close(ncid)
-
-  this%output_counter = this%output_counter + 1
-  
-  end subroutine WriteOutputNoahMP
-  
+  end subroutine CloseOutput
 
 end module ufsLandIOModule
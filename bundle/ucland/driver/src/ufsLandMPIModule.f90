@@ -0,0 +1,101 @@
+module ufsLandMPIModule
+
+! Decomposition of the land locations across MPI processes for the offline
+! driver. Each process runs the contiguous subset begsub:endsub of
+! begloc:endloc, the columns of a subset are threaded with OpenMP inside
+! noahmpdrv_run. Output and restart files hold all the locations, they are
+! written by the first process, to which the others send their subset.
+
+  use mpi
+!$ use omp_lib, only : omp_get_max_threads
+
+  implicit none
+  save
+  private
+
+  integer, public :: mpi_rank = 0
+  integer, public :: mpi_size = 1
+
+  public :: ufsLandMPIInit
+  public :: ufsLandMPIDecompose
+  public :: ufsLandMPIFinalize
+  public :: ufsLandMPITimingReport
+  public :: ufsLandMPIWtime
+
+contains
+
+  subroutine ufsLandMPIInit()
+
+  integer :: ierr, provided
+
+! the MPI calls are made by the master thread only, the other threads run
+! the physics and the asynchronous output writes
+
+  call MPI_Init_thread(MPI_THREAD_FUNNELED, provided, ierr)
+  call MPI_Comm_rank(MPI_COMM_WORLD, mpi_rank, ierr)
+  call MPI_Comm_size(MPI_COMM_WORLD, mpi_size, ierr)
+
+  end subroutine ufsLandMPIInit
+
+  subroutine ufsLandMPIDecompose(namelist)
+
+  use NamelistRead
+
+  type(namelist_type)  :: namelist
+  integer :: nlocations, nbase, nextra, nthreads
+
+! contiguous blocks, the first mod(nlocations,mpi_size) processes get one more
+
+  nlocations = namelist%endloc - namelist%begloc + 1
+  if(nlocations < mpi_size) stop "more MPI processes than locations"
+
+  nbase  = nlocations / mpi_size
+  nextra = mod(nlocations, mpi_size)
+
+  namelist%lensub = nbase
+  if(mpi_rank < nextra) namelist%lensub = nbase + 1
+  namelist%begsub = namelist%begloc + mpi_rank * nbase + min(mpi_rank, nextra)
+  namelist%endsub = namelist%begsub + namelist%lensub - 1
+
+  nthreads = 1
+!$ nthreads = omp_get_max_threads()
+
+  if(mpi_rank == 0) write(*,'(a,i6,a,i4,a)') "Running on ", mpi_size, &
+     " processes with ", nthreads, " threads each"
+  write(*,'(a,i6,a,i10,a,i10)') "Process ", mpi_rank, ": locations ", &
+     namelist%begsub, " to ", namelist%endsub
+
+  end subroutine ufsLandMPIDecompose
+
+  subroutine ufsLandMPIFinalize()
+
+  integer :: ierr
+
+  call MPI_Finalize(ierr)
+
+  end subroutine ufsLandMPIFinalize
+
+  double precision function ufsLandMPIWtime()
+
+  ufsLandMPIWtime = MPI_Wtime()
+
+  end function ufsLandMPIWtime
+
+! Print the min/max over the processes of a time spent in a part of the run
+
+  subroutine ufsLandMPITimingReport(label, seconds)
+
+  character(len=*)  :: label
+  double precision  :: seconds
+  double precision  :: tmin, tmax
+  integer :: ierr
+
+  call MPI_Reduce(seconds, tmin, 1, MPI_DOUBLE_PRECISION, MPI_MIN, 0, MPI_COMM_WORLD, ierr)
+  call MPI_Reduce(seconds, tmax, 1, MPI_DOUBLE_PRECISION, MPI_MAX, 0, MPI_COMM_WORLD, ierr)
+
+  if(mpi_rank == 0) write(*,'(a,a20,a,f12.3,a,f12.3,a)') "Timing ", label, &
+     ": min ", tmin, " s, max ", tmax, " s"
+
+  end subroutine ufsLandMPITimingReport
+
+end module ufsLandMPIModule
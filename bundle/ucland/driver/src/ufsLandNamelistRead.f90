@@ -12,6 +12,10 @@ type, public :: namelist_type
   character*128  :: output_dir
   
   logical        :: separate_output
+  integer        :: output_buffer_steps   ! time steps held in memory between writes
+  integer        :: output_deflate_level  ! > 0: NetCDF-4 file, chunked and compressed
+  logical        :: output_async          ! write the output on a background thread
+  integer        :: output_sync_steps     ! time steps between syncs of the file to disk, 0: at close
   
   integer        :: timestep_seconds
 
@@ -74,6 +78,8 @@ type, public :: namelist_type
   character*128  ::  forcing_name_specific_humidity
   character*128  ::  forcing_name_wind_speed
   character*128  ::  forcing_name_temperature
+  integer        ::  forcing_prefetch_records  ! forcing records read ahead
+  logical        ::  forcing_async             ! read ahead on a background thread
   
   contains
 
@@ -95,6 +101,10 @@ contains
     character*128  :: output_dir = ""
     
     logical        :: separate_output = .false.
+    integer        :: output_buffer_steps = 1
+    integer        :: output_deflate_level = 0
+    logical        :: output_async = .false.
+    integer        :: output_sync_steps = 1
   
     integer        :: timestep_seconds = -999
 
@@ -152,13 +162,16 @@ contains
     character*128  ::  forcing_name_pressure = ""
     character*128  ::  forcing_name_sw_radiation = ""
     character*128  ::  forcing_name_lw_radiation = ""
+    integer        ::  forcing_prefetch_records = 2
+    logical        ::  forcing_async = .false.
 
     integer, parameter :: NOAHMP_LAND_SURFACE_MODEL = 2
   
     namelist / run_setup  / static_file, init_file, forcing_dir, output_dir, timestep_seconds, &
                             simulation_start, simulation_end, run_days, run_hours, run_minutes, &
 			    run_seconds, run_timesteps, separate_output, begloc, endloc, &
-			    restart_dir, restart_frequency_s, restart_simulation, restart_date
+			    restart_dir, restart_frequency_s, restart_simulation, restart_date, &
+			    output_buffer_steps, output_deflate_level, output_async, output_sync_steps
     namelist / land_model_option / land_model
     namelist / structure  / num_soil_levels, forcing_height
     namelist / soil_setup / soil_level_thickness, soil_level_nodes
@@ -176,7 +189,8 @@ contains
                          forcing_name_precipitation     , forcing_name_temperature  , &
                          forcing_name_specific_humidity , forcing_name_wind_speed   , &
 			 forcing_name_pressure          , forcing_name_sw_radiation , &
-                         forcing_name_lw_radiation
+                         forcing_name_lw_radiation      , forcing_prefetch_records  , &
+                         forcing_async
 			 
 !---------------------------------------------------------------------
 !  read input file, part 1
@@ -222,6 +236,10 @@ contains
     this%forcing_dir          = forcing_dir
     this%output_dir           = output_dir
     this%separate_output      = separate_output
+    this%output_buffer_steps  = max(output_buffer_steps, 1)
+    this%output_deflate_level = output_deflate_level
+    this%output_async         = output_async
+    this%output_sync_steps    = max(output_sync_steps, 0)
     this%timestep_seconds     = timestep_seconds
     this%restart_frequency_s  = restart_frequency_s
     this%restart_simulation   = restart_simulation
@@ -251,6 +269,8 @@ contains
     this%forcing_name_pressure          = forcing_name_pressure
     this%forcing_name_sw_radiation      = forcing_name_sw_radiation
     this%forcing_name_lw_radiation      = forcing_name_lw_radiation
+    this%forcing_prefetch_records       = max(forcing_prefetch_records, 1)
+    this%forcing_async                  = forcing_async
     
     if(restart_simulation) then
       call calc_sec_since("1970-01-01 00:00:00",restart_date,0,run_time)
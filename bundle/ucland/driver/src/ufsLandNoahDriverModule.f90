@@ -267,6 +267,9 @@ time_loop : do timestep = 1, namelist%run_timesteps
 
 end do time_loop
 
+call output%CloseOutput()
+call forcing%ReadForcingFinalize()
+
 end associate
 
 end subroutine ufsLandNoahDriverRun 
@@ -45,7 +45,6 @@ subroutine ufsLandNoahMPDriverRun(namelist, static, forcing, noahmp)
 
 use machine , only : kind_phys
 use noahmpdrv
-use set_soilveg_mod
 use funcphys
 use namelist_soilveg, only : z0_data
 use physcons, only : con_hvap , con_cp, con_jcal, con_eps, con_epsm1,    &
@@ -61,6 +60,8 @@ use ufsLandStaticModule, only  : static_type
 use ufsLandForcingModule
 use ufsLandIOModule
 use ufsLandNoahMPRestartModule
+use ufsLandMPIModule, only     : ufsLandMPIWtime, ufsLandMPITimingReport
+!$ use omp_lib, only            : omp_set_max_active_levels
 
 type (namelist_type)  :: namelist
 type (noahmp_type)    :: noahmp
@@ -75,6 +76,8 @@ character*19     :: now_date  ! format: yyyy-mm-dd hh:nn:ss
 integer          :: now_yyyy
 
 real, allocatable, dimension(:) :: rho
+
+double precision :: time_start, time_forcing, time_physics, time_output
 real(kind=kind_phys), parameter :: one     = 1.0_kind_phys
 
 associate (                               &
@@ -214,11 +217,31 @@ allocate(   rho(im))
 flag_iter  = .true.
 flag_guess = .false.
 
-call set_soilveg(0,isot,ivegsrc,0)
+call noahmpdrv_init(0, isot, ivegsrc, 0, errmsg, errflg)
+if(errflg /= 0) then
+  write(*,*) "noahmpdrv_init reporting an error"
+  write(*,*) errmsg
+  stop
+end if
 call gpvs()
 
 zorl     = z0_data(vegtype) * 100.0   ! at driver level, roughness length in cm
 
+time_forcing = 0.d0
+time_physics = 0.d0
+time_output  = 0.d0
+
+! With output_async or forcing_async the output writes and the forcing reads
+! are run by the second thread of this region while the master thread goes
+! through the time loop. The physics threads are then a nested team, the
+! netcdf calls of the master are in the same critical section as the reads
+! and writes.
+
+!$ if(namelist%output_async .or. namelist%forcing_async) call omp_set_max_active_levels(2)
+
+!$omp parallel num_threads(2) if(namelist%output_async .or. namelist%forcing_async) default(shared)
+!$omp master
+
 time_loop : do timestep = 1, namelist%run_timesteps
 
   now_time = namelist%initial_time + timestep * namelist%timestep_seconds
@@ -231,7 +254,12 @@ time_loop : do timestep = 1, namelist%run_timesteps
   if(.not.namelist%restart_simulation .and. timestep == 1) &
      call noahmp%InitStates(namelist, now_time)
 
+  time_start = ufsLandMPIWtime()
+
   call forcing%ReadForcing(namelist, static, now_time)
+
+  time_forcing = time_forcing + ufsLandMPIWtime() - time_start
+  time_start = ufsLandMPIWtime()
   
   call interpolate_monthly(now_time, im, static%gvf_monthly, sigmaf)
   call interpolate_monthly(now_time, im, static%albedo_monthly, sfalb)
@@ -281,14 +309,21 @@ time_loop : do timestep = 1, namelist%run_timesteps
   
   where(dswsfc>0.0 .and. sfalb<0.0) dswsfc = 0.0
 
+  time_physics = time_physics + ufsLandMPIWtime() - time_start
+  time_start = ufsLandMPIWtime()
+
   call output%WriteOutputNoahMP(namelist, noahmp, forcing, now_time)
 
   if(namelist%restart_timesteps > 0) then
     if(mod(timestep,namelist%restart_timesteps) == 0) then
+      !$omp critical (ufsland_netcdf)
       call restart%WriteRestartNoahMP(namelist, noahmp, now_time)
+      !$omp end critical (ufsland_netcdf)
     end if
   end if
 
+  time_output = time_output + ufsLandMPIWtime() - time_start
+
   if(errflg /= 0) then
     write(*,*) "noahmpdrv_run reporting an error"
     write(*,*) errmsg
@@ -297,6 +332,19 @@ time_loop : do timestep = 1, namelist%run_timesteps
 
 end do time_loop
 
+time_start = ufsLandMPIWtime()
+call output%CloseOutput()
+time_output = time_output + ufsLandMPIWtime() - time_start
+
+call forcing%ReadForcingFinalize()
+
+!$omp end master
+!$omp end parallel
+
+call ufsLandMPITimingReport("forcing", time_forcing)
+call ufsLandMPITimingReport("physics", time_physics)
+call ufsLandMPITimingReport("output", time_output)
+
 end associate
 
 end subroutine ufsLandNoahMPDriverRun 
@@ -14,6 +14,15 @@ module ufsLandNoahMPRestartModule
     procedure, public  :: ReadRestartNoahMP
 
 end type noahmp_restart_type
+
+! Locations of all the processes in the restart file, on the first process
+
+  integer :: nlocations
+  integer, allocatable, dimension(:) :: outsubs, lensubs
+
+  interface PutGathered
+    module procedure PutGathered1D, PutGathered2D
+  end interface PutGathered
      
 contains   
 
@@ -24,6 +33,7 @@ contains
   use error_handling, only : handle_err
   use NamelistRead
   use ufsLandNoahMPType
+  use ufsLandMPIModule, only : mpi_rank
 
   class(noahmp_restart_type)   :: this  
   type(namelist_type)  :: namelist
@@ -51,6 +61,13 @@ contains
 
   this%filename = trim(namelist%restart_dir)//"/"//trim(this%filename)
 
+! The file holds all the locations. Only the first process creates, defines
+! and writes it, the others send it their locations in PutGathered.
+
+  call GatherLayout(outsub, noahmp%static%im)
+
+  if(mpi_rank == 0) then
+
   write(*,*) "Creating: "//trim(this%filename)
 
   status = nf90_create(this%filename, NF90_CLOBBER, ncid)
@@ -58,7 +75,7 @@ contains
 
 ! Define dimensions in the file.
 
-  status = nf90_def_dim(ncid, "location"    , noahmp%static%im     , dim_id_loc)
+  status = nf90_def_dim(ncid, "location"    , nlocations           , dim_id_loc)
     if (status /= nf90_noerr) call handle_err(status)
   status = nf90_def_dim(ncid, "soil_levels" , noahmp%static%km     , dim_id_soil)
     if (status /= nf90_noerr) call handle_err(status)
@@ -425,351 +442,269 @@ contains
   status = nf90_inq_varid(ncid, "delt", varid)
   status = nf90_put_var(ncid, varid , noahmp%static%delt   )
 
-  status = nf90_inq_varid(ncid, "sigmaf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sigmaf        , &
+  end if
+
+  status = PutGathered(ncid, "sigmaf", noahmp%model%sigmaf        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "emiss", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%emiss         , &
+  status = PutGathered(ncid, "emiss", noahmp%model%emiss         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "albdvis", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albdvis       , &
+  status = PutGathered(ncid, "albdvis", noahmp%model%albdvis       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "albdnir", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albdnir       , &
+  status = PutGathered(ncid, "albdnir", noahmp%model%albdnir       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "albivis", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albivis       , &
+  status = PutGathered(ncid, "albivis", noahmp%model%albivis       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "albinir", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%albinir       , &
+  status = PutGathered(ncid, "albinir", noahmp%model%albinir       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "snet", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snet          , &
+  status = PutGathered(ncid, "snet", noahmp%model%snet          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "tg3", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tg3           , &
+  status = PutGathered(ncid, "tg3", noahmp%model%tg3           , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "cm", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%cm            , &
+  status = PutGathered(ncid, "cm", noahmp%model%cm            , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "ch", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%ch            , &
+  status = PutGathered(ncid, "ch", noahmp%model%ch            , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "prsl1", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%prsl1         , &
+  status = PutGathered(ncid, "prsl1", noahmp%model%prsl1         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "prslki", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%prslki        , &
+  status = PutGathered(ncid, "prslki", noahmp%model%prslki        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "zf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zf            , &
+  status = PutGathered(ncid, "zf", noahmp%model%zf            , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "shdmin", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%shdmin        , &
+  status = PutGathered(ncid, "shdmin", noahmp%model%shdmin        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "shdmax", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%shdmax        , &
+  status = PutGathered(ncid, "shdmax", noahmp%model%shdmax        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "snoalb", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snoalb        , &
+  status = PutGathered(ncid, "snoalb", noahmp%model%snoalb        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "sfalb", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sfalb         , &
+  status = PutGathered(ncid, "sfalb", noahmp%model%sfalb         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "weasd", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%weasd         , &
+  status = PutGathered(ncid, "weasd", noahmp%model%weasd         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "snwdph", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snwdph        , &
+  status = PutGathered(ncid, "snwdph", noahmp%model%snwdph        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "tskin", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tskin         , &
+  status = PutGathered(ncid, "tskin", noahmp%model%tskin         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "srflag", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%srflag        , &
+  status = PutGathered(ncid, "srflag", noahmp%model%srflag        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "smc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smc , &
+  status = PutGathered(ncid, "smc", noahmp%model%smc , &
       start = (/          outsub,                1, 1/), &
       count = (/noahmp%static%im, noahmp%static%km, 1/))
 
-  status = nf90_inq_varid(ncid, "stc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stc , &
+  status = PutGathered(ncid, "stc", noahmp%model%stc , &
       start = (/          outsub,                1, 1/), &
       count = (/noahmp%static%im, noahmp%static%km, 1/))
 
-  status = nf90_inq_varid(ncid, "slc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%slc , &
+  status = PutGathered(ncid, "slc", noahmp%model%slc , &
       start = (/          outsub,                1, 1/), &
       count = (/noahmp%static%im, noahmp%static%km, 1/))
 
-  status = nf90_inq_varid(ncid, "canopy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%canopy        , &
+  status = PutGathered(ncid, "canopy", noahmp%model%canopy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "trans", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%trans         , &
+  status = PutGathered(ncid, "trans", noahmp%model%trans         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "tsurf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tsurf         , &
+  status = PutGathered(ncid, "tsurf", noahmp%model%tsurf         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "zorl", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zorl          , &
+  status = PutGathered(ncid, "zorl", noahmp%model%zorl          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "sncovr1", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sncovr1       , &
+  status = PutGathered(ncid, "sncovr1", noahmp%model%sncovr1       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "qsurf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%qsurf         , &
+  status = PutGathered(ncid, "qsurf", noahmp%model%qsurf         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "gflux", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%gflux         , &
+  status = PutGathered(ncid, "gflux", noahmp%model%gflux         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "drain", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%drain         , &
+  status = PutGathered(ncid, "drain", noahmp%model%drain         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "evap", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%evap          , &
+  status = PutGathered(ncid, "evap", noahmp%model%evap          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "hflx", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%hflx          , &
+  status = PutGathered(ncid, "hflx", noahmp%model%hflx          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "ep", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%ep            , &
+  status = PutGathered(ncid, "ep", noahmp%model%ep            , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "runoff", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%runoff        , &
+  status = PutGathered(ncid, "runoff", noahmp%model%runoff        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "cmm", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%cmm           , &
+  status = PutGathered(ncid, "cmm", noahmp%model%cmm           , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "chh", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%chh           , &
+  status = PutGathered(ncid, "chh", noahmp%model%chh           , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "evbs", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%evbs          , &
+  status = PutGathered(ncid, "evbs", noahmp%model%evbs          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "evcw", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%evcw          , &
+  status = PutGathered(ncid, "evcw", noahmp%model%evcw          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "sbsno", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sbsno         , &
+  status = PutGathered(ncid, "sbsno", noahmp%model%sbsno         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "snowc", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snowc         , &
+  status = PutGathered(ncid, "snowc", noahmp%model%snowc         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "stm", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stm           , &
+  status = PutGathered(ncid, "stm", noahmp%model%stm           , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "snohf", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snohf         , &
+  status = PutGathered(ncid, "snohf", noahmp%model%snohf         , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "smcwlt2", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smcwlt2       , &
+  status = PutGathered(ncid, "smcwlt2", noahmp%model%smcwlt2       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "smcref2", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smcref2       , &
+  status = PutGathered(ncid, "smcref2", noahmp%model%smcref2       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "wet1", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%wet1          , &
+  status = PutGathered(ncid, "wet1", noahmp%model%wet1          , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "xcoszin", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%xcoszin     , &
+  status = PutGathered(ncid, "xcoszin", noahmp%model%xcoszin     , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "snowxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snowxy      , &
+  status = PutGathered(ncid, "snowxy", noahmp%model%snowxy      , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "tvxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tvxy        , &
+  status = PutGathered(ncid, "tvxy", noahmp%model%tvxy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "tgxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tgxy        , &
+  status = PutGathered(ncid, "tgxy", noahmp%model%tgxy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "canicexy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%canicexy    , &
+  status = PutGathered(ncid, "canicexy", noahmp%model%canicexy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "canliqxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%canliqxy    , &
+  status = PutGathered(ncid, "canliqxy", noahmp%model%canliqxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "eahxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%eahxy       , &
+  status = PutGathered(ncid, "eahxy", noahmp%model%eahxy       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "tahxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tahxy       , &
+  status = PutGathered(ncid, "tahxy", noahmp%model%tahxy       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "cmxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%cmxy        , &
+  status = PutGathered(ncid, "cmxy", noahmp%model%cmxy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "chxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%chxy        , &
+  status = PutGathered(ncid, "chxy", noahmp%model%chxy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "fwetxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%fwetxy      , &
+  status = PutGathered(ncid, "fwetxy", noahmp%model%fwetxy      , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "sneqvoxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%sneqvoxy    , &
+  status = PutGathered(ncid, "sneqvoxy", noahmp%model%sneqvoxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "alboldxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%alboldxy    , &
+  status = PutGathered(ncid, "alboldxy", noahmp%model%alboldxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "qsnowxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%qsnowxy     , &
+  status = PutGathered(ncid, "qsnowxy", noahmp%model%qsnowxy     , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "wslakexy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%wslakexy    , &
+  status = PutGathered(ncid, "wslakexy", noahmp%model%wslakexy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "zwtxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zwtxy       , &
+  status = PutGathered(ncid, "zwtxy", noahmp%model%zwtxy       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "waxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%waxy        , &
+  status = PutGathered(ncid, "waxy", noahmp%model%waxy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "wtxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%wtxy        , &
+  status = PutGathered(ncid, "wtxy", noahmp%model%wtxy        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "lfmassxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%lfmassxy    , &
+  status = PutGathered(ncid, "lfmassxy", noahmp%model%lfmassxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "rtmassxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%rtmassxy    , &
+  status = PutGathered(ncid, "rtmassxy", noahmp%model%rtmassxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "stmassxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stmassxy    , &
+  status = PutGathered(ncid, "stmassxy", noahmp%model%stmassxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "woodxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%woodxy      , &
+  status = PutGathered(ncid, "woodxy", noahmp%model%woodxy      , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "stblcpxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%stblcpxy    , &
+  status = PutGathered(ncid, "stblcpxy", noahmp%model%stblcpxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "fastcpxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%fastcpxy    , &
+  status = PutGathered(ncid, "fastcpxy", noahmp%model%fastcpxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "xlaixy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%xlaixy      , &
+  status = PutGathered(ncid, "xlaixy", noahmp%model%xlaixy      , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "xsaixy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%xsaixy      , &
+  status = PutGathered(ncid, "xsaixy", noahmp%model%xsaixy      , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "taussxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%taussxy     , &
+  status = PutGathered(ncid, "taussxy", noahmp%model%taussxy     , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "smcwtdxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smcwtdxy    , &
+  status = PutGathered(ncid, "smcwtdxy", noahmp%model%smcwtdxy    , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "deeprechxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model% deeprechxy , &
+  status = PutGathered(ncid, "deeprechxy", noahmp%model% deeprechxy , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "rechxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%rechxy      , &
+  status = PutGathered(ncid, "rechxy", noahmp%model%rechxy      , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "t2mmp", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%t2mmp       , &
+  status = PutGathered(ncid, "t2mmp", noahmp%model%t2mmp       , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "q2mp", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%q2mp        , &
+  status = PutGathered(ncid, "q2mp", noahmp%model%q2mp        , &
       start = (/outsub,1/), count = (/noahmp%static%im, 1/))
 
-  status = nf90_inq_varid(ncid, "smoiseq", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%smoiseq , &
+  status = PutGathered(ncid, "smoiseq", noahmp%model%smoiseq , &
       start = (/outsub          ,                1, 1/), &
       count = (/noahmp%static%im, noahmp%static%km, 1/))
 
-  status = nf90_inq_varid(ncid, "zsnsoxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%zsnsoxy , &
+  status = PutGathered(ncid, "zsnsoxy", noahmp%model%zsnsoxy , &
       start = (/outsub          ,                  1, 1/), &
       count = (/noahmp%static%im, noahmp%static%km+3, 1/))
 
-  status = nf90_inq_varid(ncid, "tsnoxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%tsnoxy , &
+  status = PutGathered(ncid, "tsnoxy", noahmp%model%tsnoxy , &
       start = (/outsub          ,              1, 1/), &
       count = (/noahmp%static%im,              3, 1/))
 
-  status = nf90_inq_varid(ncid, "snicexy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snicexy , &
+  status = PutGathered(ncid, "snicexy", noahmp%model%snicexy , &
       start = (/outsub          ,              1, 1/), &
       count = (/noahmp%static%im,              3, 1/))
 
-  status = nf90_inq_varid(ncid, "snliqxy", varid)
-  status = nf90_put_var(ncid, varid , noahmp%model%snliqxy , &
+  status = PutGathered(ncid, "snliqxy", noahmp%model%snliqxy , &
       start = (/outsub          ,              1, 1/), &
       count = (/noahmp%static%im,              3, 1/))
 
-  status = nf90_close(ncid)
+  if(mpi_rank == 0) status = nf90_close(ncid)
 
   end subroutine WriteRestartNoahMP
   
@@ -1166,4 +1101,106 @@ contains
 
   end subroutine ReadRestartNoahMP
 
+! Collect on the first process where the locations of every process go in
+! the restart file, collective
+
+  subroutine GatherLayout(outsub, lensub)
+
+  use mpi
+  use ufsLandMPIModule, only : mpi_rank, mpi_size
+
+  integer :: outsub, lensub
+  integer :: ierr
+
+  if(allocated(outsubs)) deallocate(outsubs, lensubs)
+  allocate(outsubs(0:mpi_size-1), lensubs(0:mpi_size-1))
+
+  call MPI_Gather(outsub, 1, MPI_INTEGER, outsubs, 1, MPI_INTEGER, 0, MPI_COMM_WORLD, ierr)
+  call MPI_Gather(lensub, 1, MPI_INTEGER, lensubs, 1, MPI_INTEGER, 0, MPI_COMM_WORLD, ierr)
+  if(mpi_rank == 0) nlocations = sum(lensubs)
+
+  end subroutine GatherLayout
+
+! Write a (location) or (location,level) variable: the values of all the
+! processes are gathered on the first process, which writes them with one
+! nf90_put_var. start and count are the ones of the calling process, only
+! their non-location part is used. Collective.
+
+  integer function PutGathered1D(ncid, name, values, start, count) result(status)
+
+  use netcdf
+  use mpi
+  use machine, only : kind_phys
+  use ufsLandMPIModule, only : mpi_rank
+
+  integer              :: ncid
+  character(len=*)     :: name
+  real(kind=kind_phys), dimension(:) :: values
+  integer, dimension(2) :: start, count
+  real(kind=kind_phys), allocatable, dimension(:) :: global
+  integer :: varid, mpi_type, ierr
+
+  mpi_type = MPI_DOUBLE_PRECISION
+  if(kind_phys == 4) mpi_type = MPI_REAL
+
+  if(mpi_rank == 0) then
+    allocate(global(nlocations))
+  else
+    allocate(global(1))
+  end if
+
+  call MPI_Gatherv(values, count(1), mpi_type, global, lensubs, outsubs-1, mpi_type, &
+                   0, MPI_COMM_WORLD, ierr)
+
+  status = nf90_noerr
+  if(mpi_rank == 0) then
+    status = nf90_inq_varid(ncid, name, varid)
+    if(status == nf90_noerr) &
+      status = nf90_put_var(ncid, varid, global, start = (/1, start(2)/), &
+                            count = (/nlocations, count(2)/))
+  end if
+
+  end function PutGathered1D
+
+  integer function PutGathered2D(ncid, name, values, start, count) result(status)
+
+  use netcdf
+  use mpi
+  use machine, only : kind_phys
+  use ufsLandMPIModule, only : mpi_rank
+
+  integer              :: ncid
+  character(len=*)     :: name
+  real(kind=kind_phys), dimension(:,:) :: values
+  integer, dimension(3) :: start, count
+  real(kind=kind_phys), allocatable, dimension(:,:) :: global
+  real(kind=kind_phys), allocatable, dimension(:)   :: level
+  integer :: varid, mpi_type, ierr, k
+
+  mpi_type = MPI_DOUBLE_PRECISION
+  if(kind_phys == 4) mpi_type = MPI_REAL
+
+  if(mpi_rank == 0) then
+    allocate(global(nlocations, count(2)))
+  else
+    allocate(global(1, count(2)))
+  end if
+  allocate(level(count(1)))
+
+  do k = 1, count(2)
+    level = values(1:count(1), k)
+    call MPI_Gatherv(level, count(1), mpi_type, global(:, k), lensubs, outsubs-1, mpi_type, &
+                     0, MPI_COMM_WORLD, ierr)
+  end do
+
+  status = nf90_noerr
+  if(mpi_rank == 0) then
+    status = nf90_inq_varid(ncid, name, varid)
+    if(status == nf90_noerr) &
+      status = nf90_put_var(ncid, varid, global, start = (/1, start(2), start(3)/), &
+                            count = (/nlocations, count(2), count(3)/))
+  end if
+
+  end function PutGathered2D
+
 end module ufsLandNoahMPRestartModule
@@ -0,0 +1,500 @@
+module ufsLandWriterModule
+
+! Writer for the time series output files of the offline driver. The file
+! stays open from Create to Close, the variable ids are kept, and the values
+! of buffer_steps time steps are held in memory and written with one
+! nf90_put_var per variable. The processes send their locations to the first
+! process, which is the only one touching the file.
+!
+! With async the write of the buffered steps is an OpenMP task, run by an
+! idle thread of the enclosing parallel region (see ufsLandNoahMPDriverRun)
+! while the model goes on. The values are copied to a second buffer before
+! the task starts, only one write task is in flight at a time, and the
+! netcdf calls are made in the ufsland_netcdf critical section since the
+! netcdf library is not thread safe.
+!
+! The file is synced to disk once sync_steps steps have been written since
+! the last sync, so a run that stops early leaves a readable file with the
+! steps written so far. With sync_steps = 0 it is only synced by the close.
+
+  use machine, only : kind_phys
+  use netcdf
+  use error_handling, only : handle_err
+  use mpi
+  use ufsLandMPIModule, only : mpi_rank, mpi_size
+
+  implicit none
+  save
+  private
+
+  integer, parameter :: max_dims = 8
+  integer, parameter :: name_length = 32
+
+  type :: writer_var_type
+    character(len=name_length) :: name
+    integer          :: nlev        ! 0 for a variable that only depends on time
+    logical          :: has_levels
+    integer          :: varid
+    real(kind=4), allocatable, dimension(:,:,:)   :: buffer  ! (lensub,nlev,buffer_steps)
+    real(kind=4), allocatable, dimension(:,:,:,:) :: global  ! (nlocations,nlev,buffer_steps,2)
+  end type writer_var_type
+
+  type, public :: output_writer_type
+
+    logical          :: is_open = .false.
+    integer          :: ncid
+    integer          :: dim_id_loc, dim_id_time
+    integer          :: time_varid
+    integer          :: nlocations     ! locations in the file
+    integer          :: outsub         ! first location of this process in the file
+    integer          :: lensub         ! locations of this process
+    integer          :: buffer_steps
+    integer          :: deflate_level
+    logical          :: async
+    integer          :: sync_steps     ! steps between nf90_sync, 0 for none
+
+    integer          :: ndims = 0
+    character(len=name_length), dimension(max_dims) :: dim_names
+    integer,                    dimension(max_dims) :: dim_lengths
+    integer,                    dimension(max_dims) :: dim_ids
+
+    integer          :: nvars = 0
+    type(writer_var_type), allocatable, dimension(:) :: vars
+    integer          :: current = 0    ! last variable put, the next lookup starts after it
+
+    integer          :: nbuffered = 0  ! complete steps in the buffers
+    integer          :: records = 0    ! steps written or being written to the file
+    integer          :: ibuf = 1       ! next second buffer to fill
+    double precision, allocatable, dimension(:)   :: times         ! (buffer_steps)
+    double precision, allocatable, dimension(:,:) :: global_times  ! (buffer_steps,2)
+
+    integer, allocatable, dimension(:) :: outsubs, lensubs   ! of all the processes
+
+  contains
+
+    procedure, public  :: Create
+    procedure, public  :: DefineDim
+    procedure, public  :: DefineVar
+    procedure, public  :: EndDefine
+    procedure, public  :: Advance
+    procedure, public  :: Flush => FlushWriter
+    procedure, public  :: Close => CloseWriter
+    generic,   public  :: Put => PutScalar, Put1D, Put2D
+    procedure          :: PutScalar
+    procedure          :: Put1D
+    procedure          :: Put2D
+    procedure          :: FindVar
+    procedure          :: WriteRecords
+
+  end type output_writer_type
+
+contains
+
+! Start a new file, collective over the processes. The location and time
+! dimensions and the time variable are defined here.
+
+  subroutine Create(this, filename, reference_date, nlocations, outsub, lensub, &
+                    buffer_steps, deflate_level, async, sync_steps)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: filename
+  character(len=*)     :: reference_date
+  integer              :: nlocations, outsub, lensub
+  integer              :: buffer_steps, deflate_level
+  logical              :: async
+  integer              :: sync_steps
+  integer :: status, ierr, cmode
+
+  if(this%is_open) call this%Close()
+
+  this%nlocations    = nlocations
+  this%outsub        = outsub
+  this%lensub        = lensub
+  this%buffer_steps  = max(buffer_steps, 1)
+  this%deflate_level = deflate_level
+  this%async         = async
+  this%sync_steps    = sync_steps
+  this%ndims         = 0
+  this%nvars         = 0
+  this%current       = 0
+  this%nbuffered     = 0
+  this%records       = 0
+  this%ibuf          = 1
+
+  if(allocated(this%vars)) deallocate(this%vars)
+  allocate(this%vars(64))
+
+  if(allocated(this%outsubs)) deallocate(this%outsubs, this%lensubs)
+  allocate(this%outsubs(0:mpi_size-1), this%lensubs(0:mpi_size-1))
+  if(mpi_size > 1) then
+    call MPI_Gather(outsub, 1, MPI_INTEGER, this%outsubs, 1, MPI_INTEGER, 0, MPI_COMM_WORLD, ierr)
+    call MPI_Gather(lensub, 1, MPI_INTEGER, this%lensubs, 1, MPI_INTEGER, 0, MPI_COMM_WORLD, ierr)
+  else
+    this%outsubs = outsub
+    this%lensubs = lensub
+  end if
+
+  if(mpi_rank == 0) then
+
+    write(*,*) "Creating: "//trim(filename)
+
+    cmode = NF90_CLOBBER
+    if(deflate_level > 0) cmode = ior(cmode, NF90_NETCDF4)
+
+    status = nf90_create(filename, cmode, this%ncid)
+      if (status /= nf90_noerr) call handle_err(status)
+
+    status = nf90_def_dim(this%ncid, "location", nlocations    , this%dim_id_loc)
+      if (status /= nf90_noerr) call handle_err(status)
+    status = nf90_def_dim(this%ncid, "time"    , NF90_UNLIMITED, this%dim_id_time)
+      if (status /= nf90_noerr) call handle_err(status)
+
+    status = nf90_def_var(this%ncid, "time", NF90_DOUBLE, this%dim_id_time, this%time_varid)
+      if (status /= nf90_noerr) call handle_err(status)
+      status = nf90_put_att(this%ncid, this%time_varid, "long_name", "time")
+      status = nf90_put_att(this%ncid, this%time_varid, "units", "seconds since "//reference_date)
+
+  end if
+
+  this%is_open = .true.
+
+  end subroutine Create
+
+! Define a vertical dimension
+
+  subroutine DefineDim(this, name, length)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: name
+  integer              :: length
+  integer :: status
+
+  if(this%ndims == max_dims) stop "too many dimensions in output file"
+
+  this%ndims = this%ndims + 1
+  this%dim_names(this%ndims)   = name
+  this%dim_lengths(this%ndims) = length
+
+  if(mpi_rank == 0) then
+    status = nf90_def_dim(this%ncid, name, length, this%dim_ids(this%ndims))
+      if (status /= nf90_noerr) call handle_err(status)
+  end if
+
+  end subroutine DefineDim
+
+! Define a float variable on (location,time), (location,levels,time) if
+! levels is the name of a dimension from DefineDim, or (time) with time_only
+
+  subroutine DefineVar(this, name, long_name, units, levels, time_only)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: name, long_name, units
+  character(len=*), optional :: levels
+  logical, optional    :: time_only
+  type(writer_var_type), allocatable, dimension(:) :: vars
+  integer, dimension(3) :: dimids, chunks
+  integer :: status, ndims, idim
+
+  if(this%nvars == size(this%vars)) then
+    allocate(vars(2*size(this%vars)))
+    vars(1:this%nvars) = this%vars(1:this%nvars)
+    call move_alloc(vars, this%vars)
+  end if
+
+  this%nvars = this%nvars + 1
+
+  associate(var => this%vars(this%nvars))
+
+  var%name       = name
+  var%nlev       = 1
+  var%has_levels = .false.
+
+  ndims = 2
+  dimids(1:2) = (/this%dim_id_loc, this%dim_id_time/)
+  chunks(1:2) = (/this%nlocations, this%buffer_steps/)
+
+  if(present(levels)) then
+    do idim = 1, this%ndims
+      if(this%dim_names(idim) == levels) exit
+    end do
+    if(idim > this%ndims) stop "output variable on an undefined dimension"
+    var%nlev       = this%dim_lengths(idim)
+    var%has_levels = .true.
+    ndims = 3
+    dimids(1:3) = (/this%dim_id_loc, this%dim_ids(idim), this%dim_id_time/)
+    chunks(1:3) = (/this%nlocations, var%nlev, this%buffer_steps/)
+  end if
+
+  if(present(time_only)) then
+    if(time_only) then
+      var%nlev = 0
+      ndims = 1
+      dimids(1) = this%dim_id_time
+      chunks(1) = this%buffer_steps
+    end if
+  end if
+
+  if(mpi_rank == 0) then
+    if(this%deflate_level > 0) then
+      status = nf90_def_var(this%ncid, name, NF90_FLOAT, dimids(1:ndims), var%varid, &
+                            chunksizes = chunks(1:ndims), shuffle = .true.,         &
+                            deflate_level = this%deflate_level)
+    else
+      status = nf90_def_var(this%ncid, name, NF90_FLOAT, dimids(1:ndims), var%varid)
+    end if
+      if (status /= nf90_noerr) call handle_err(status)
+      status = nf90_put_att(this%ncid, var%varid, "long_name", long_name)
+      status = nf90_put_att(this%ncid, var%varid, "units", units)
+  end if
+
+  end associate
+
+  end subroutine DefineVar
+
+! Leave define mode and allocate the buffers
+
+  subroutine EndDefine(this)
+
+  class(output_writer_type) :: this
+  integer :: status, ivar, npts, nlev
+
+  if(mpi_rank == 0) then
+    status = nf90_enddef(this%ncid)
+      if (status /= nf90_noerr) call handle_err(status)
+  end if
+
+  do ivar = 1, this%nvars
+    associate(var => this%vars(ivar))
+    npts = this%lensub
+    nlev = max(var%nlev, 1)
+    if(var%nlev == 0) npts = 1
+    allocate(var%buffer(npts, nlev, this%buffer_steps))
+    if(mpi_rank == 0) then
+      if(var%nlev /= 0) npts = this%nlocations
+      allocate(var%global(npts, nlev, this%buffer_steps, 2))
+    end if
+    end associate
+  end do
+
+  if(allocated(this%times)) deallocate(this%times, this%global_times)
+  allocate(this%times(this%buffer_steps), this%global_times(this%buffer_steps, 2))
+
+  end subroutine EndDefine
+
+! Store the values of the current step. Variables are found by name, in
+! constant time when they are put in the order they were defined.
+
+  subroutine PutScalar(this, name, value)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: name
+  real(kind=kind_phys) :: value
+  integer :: ivar
+
+  ivar = this%FindVar(name)
+  this%vars(ivar)%buffer(1, 1, this%nbuffered+1) = real(value, 4)
+
+  end subroutine PutScalar
+
+  subroutine Put1D(this, name, values)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: name
+  real(kind=kind_phys), dimension(:) :: values
+  integer :: ivar
+
+  ivar = this%FindVar(name)
+  this%vars(ivar)%buffer(:, 1, this%nbuffered+1) = real(values, 4)
+
+  end subroutine Put1D
+
+  subroutine Put2D(this, name, values)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: name
+  real(kind=kind_phys), dimension(:,:) :: values
+  integer :: ivar
+
+  ivar = this%FindVar(name)
+  this%vars(ivar)%buffer(:, :, this%nbuffered+1) = real(values, 4)
+
+  end subroutine Put2D
+
+  integer function FindVar(this, name)
+
+  class(output_writer_type) :: this
+  character(len=*)     :: name
+  integer :: i
+
+  do i = 1, this%nvars
+    FindVar = mod(this%current + i - 1, this%nvars) + 1
+    if(this%vars(FindVar)%name == name) then
+      this%current = FindVar
+      return
+    end if
+  end do
+
+  write(*,*) "output variable not defined: "//trim(name)
+  stop
+
+  end function FindVar
+
+! Close the current step, the buffers are written once full
+
+  subroutine Advance(this, now_time)
+
+  class(output_writer_type) :: this
+  double precision     :: now_time
+
+  this%nbuffered = this%nbuffered + 1
+  this%times(this%nbuffered) = now_time
+
+  if(this%nbuffered == this%buffer_steps) call this%Flush()
+
+  end subroutine Advance
+
+! Collect the buffered steps on the first process and write them,
+! collective over the processes
+
+  subroutine FlushWriter(this)
+
+  class(output_writer_type) :: this
+  real(kind=4), allocatable, dimension(:) :: gathered
+  integer, allocatable, dimension(:) :: counts, displs
+  integer :: ivar, nb, nlev, ib, rec0, iproc, ierr
+
+  nb = this%nbuffered
+  if(nb == 0) return
+  ib = this%ibuf
+
+  if(mpi_size > 1) then
+    allocate(counts(0:mpi_size-1), displs(0:mpi_size-1))
+    if(mpi_rank == 0) then
+      allocate(gathered(this%nlocations * maxval(this%vars(1:this%nvars)%nlev) * nb))
+    else
+      allocate(gathered(1))
+    end if
+  end if
+
+  do ivar = 1, this%nvars
+    associate(var => this%vars(ivar))
+
+    if(var%nlev == 0) then
+      if(mpi_rank == 0) var%global(1, 1, 1:nb, ib) = var%buffer(1, 1, 1:nb)
+      cycle
+    end if
+
+    if(mpi_size == 1) then
+      var%global(this%outsub:this%outsub+this%lensub-1, :, 1:nb, ib) = var%buffer(:, :, 1:nb)
+      cycle
+    end if
+
+    nlev = var%nlev
+    if(mpi_rank == 0) then
+      counts = this%lensubs * nlev * nb
+      displs(0) = 0
+      do iproc = 1, mpi_size-1
+        displs(iproc) = displs(iproc-1) + counts(iproc-1)
+      end do
+    end if
+
+    call MPI_Gatherv(var%buffer, this%lensub*nlev*nb, MPI_REAL, gathered, counts, displs, &
+                     MPI_REAL, 0, MPI_COMM_WORLD, ierr)
+
+    if(mpi_rank == 0) then
+      do iproc = 0, mpi_size-1
+        var%global(this%outsubs(iproc):this%outsubs(iproc)+this%lensubs(iproc)-1, :, 1:nb, ib) = &
+          reshape(gathered(displs(iproc)+1:displs(iproc)+counts(iproc)), &
+                  (/this%lensubs(iproc), nlev, nb/))
+      end do
+    end if
+
+    end associate
+  end do
+
+  this%global_times(1:nb, ib) = this%times(1:nb)
+
+! the previous write has been running while the model and the gather above
+! went on, it must be done before the next one starts
+
+  !$omp taskwait
+
+  if(mpi_rank == 0) then
+    rec0 = this%records + 1
+    !$omp task default(shared) firstprivate(ib, nb, rec0) if(this%async)
+    call this%WriteRecords(ib, nb, rec0)
+    !$omp end task
+  end if
+
+  this%records   = this%records + nb
+  this%nbuffered = 0
+  this%ibuf      = 3 - ib
+
+  end subroutine FlushWriter
+
+! Write nb steps from the second buffer ib, starting at record rec0
+
+  subroutine WriteRecords(this, ib, nb, rec0)
+
+  class(output_writer_type) :: this
+  integer              :: ib, nb, rec0
+  integer :: status, ivar
+
+  !$omp critical (ufsland_netcdf)
+
+  status = nf90_put_var(this%ncid, this%time_varid, this%global_times(1:nb, ib), &
+      start = (/rec0/), count = (/nb/))
+    if (status /= nf90_noerr) call handle_err(status)
+
+  do ivar = 1, this%nvars
+    associate(var => this%vars(ivar))
+    if(var%nlev == 0) then
+      status = nf90_put_var(this%ncid, var%varid, var%global(1, 1, 1:nb, ib), &
+          start = (/rec0/), count = (/nb/))
+    elseif(var%has_levels) then
+      status = nf90_put_var(this%ncid, var%varid, var%global(:, :, 1:nb, ib), &
+          start = (/1, 1, rec0/), count = (/this%nlocations, var%nlev, nb/))
+    else
+      status = nf90_put_var(this%ncid, var%varid, var%global(:, 1, 1:nb, ib), &
+          start = (/1, rec0/), count = (/this%nlocations, nb/))
+    end if
+      if (status /= nf90_noerr) call handle_err(status)
+    end associate
+  end do
+
+  if(this%sync_steps > 0) then
+    if((rec0+nb-1)/this%sync_steps > (rec0-1)/this%sync_steps) then
+      status = nf90_sync(this%ncid)
+        if (status /= nf90_noerr) call handle_err(status)
+    end if
+  end if
+
+  !$omp end critical (ufsland_netcdf)
+
+  end subroutine WriteRecords
+
+! Write what is left in the buffers and close the file, collective
+
+  subroutine CloseWriter(this)
+
+  class(output_writer_type) :: this
+  integer :: status
+
+  if(.not.this%is_open) return
+
+  call this%Flush()
+
+  !$omp taskwait
+
+  if(mpi_rank == 0) then
+    status = nf90_close(this%ncid)
+      if (status /= nf90_noerr) call handle_err(status)
+  end if
+
+  deallocate(this%vars, this%times, this%global_times)
+  this%nvars   = 0
+  this%is_open = .false.
+
+  end subroutine CloseWriter
+
+end module ufsLandWriterModule
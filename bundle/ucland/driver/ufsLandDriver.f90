@@ -7,6 +7,7 @@ program ufsLandDriver
   use NamelistRead
   use ufsLandStaticModule, only  : static_type
   use ufsLandForcingModule, only : forcing_type
+  use ufsLandMPIModule
 
   implicit none
   
@@ -19,16 +20,18 @@ program ufsLandDriver
   integer, parameter :: NOAH_LAND_SURFACE_MODEL = 1
   integer, parameter :: NOAHMP_LAND_SURFACE_MODEL = 2
 
+  call ufsLandMPIInit()
+
   call namelist%ReadNamelist()
   
-  namelist%begsub = namelist%begloc
-  namelist%endsub = namelist%endloc
-  namelist%lensub = namelist%endloc - namelist%begloc + 1
+  call ufsLandMPIDecompose(namelist)
   
   land_model : select case(namelist%land_model)
   
     case(NOAH_LAND_SURFACE_MODEL)
 
+      if(mpi_size > 1) stop "the noah land_model only runs on one process"
+
       call ufsLandNoahDriverInit(namelist, static, forcing, noah)
 
       call ufsLandNoahDriverRun(namelist, static, forcing, noah)
@@ -48,6 +51,8 @@ program ufsLandDriver
       stop "no valid land_model set in namelist"
 
   end select land_model
+
+  call ufsLandMPIFinalize()
    
 end program
 
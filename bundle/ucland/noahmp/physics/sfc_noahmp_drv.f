@@ -10,12 +10,23 @@
 !> This module contains the CCPP-compliant NoahMP land surface model driver.
       module noahmpdrv
 
+      use module_sf_noahmplsm, only : noahmp_parameters
+
       implicit none
 
       private
 
       public :: noahmpdrv_init, noahmpdrv_run, noahmpdrv_finalize
 
+!  --- ...  the noahmp_parameters of a column only depend on its
+!           (vegetation, soil, slope) types, the soil color is fixed, so
+!           they are filled once for every combination in noahmpdrv_init
+!           and only read in the column loop, see mp_parameters_table()
+
+      integer, parameter :: isc = 4   ! middle day soil color: soil 1-9 lightest
+
+      type(noahmp_parameters), allocatable, save :: mp_table(:,:,:) ! veg,soil,slope
+
       contains
 
 !> \ingroup NoahMP_LSM
@@ -54,6 +65,9 @@
 
         !--- initialize soil vegetation
         call set_soilveg(me, isot, ivegsrc, nlunit)
+
+        !--- noahmp parameters of all the types
+        call mp_parameters_table()
       
       end subroutine noahmpdrv_init
 
@@ -72,7 +86,7 @@
 !!    - This driver may be called as part of an iterative loop. If called as the first "guess" run, 
 !!        save land-related prognostic fields to restore.
 !!    - Initialize output variables to zero and prepare variables for input into the NoahMP LSM.
-!!    - Call transfer_mp_parameters() to fill a derived datatype for input into the NoahMP LSM.
+!!    - Read the derived datatype of parameters for input into the NoahMP LSM from the table filled in noahmpdrv_init().
 !!    - Call noahmp_options() to set module-level scheme options for the NoahMP LSM.
 !!    - If the vegetation type is ice for the grid cell, call noahmp_options_glacier() to set 
 !!        module-level scheme options for NoahMP Glacier and call noahmp_glacier().
@@ -143,7 +157,6 @@
       integer                         :: nsoil   = 4   ! hardwired to Noah
       integer                         :: nsnow   = 3   ! max. snow layers
       integer                         :: ist     = 1   ! soil type, 1 soil; 2  lake;  14 is water
-      integer                         :: isc     = 4   ! middle day soil color: soil 1-9 lightest
 
       real(kind=kind_phys), save  :: zsoil(4),sldpth(4)
       data zsoil / -0.1, -0.4, -1.0, -2.0 /
@@ -285,12 +298,13 @@
       integer :: i, k, ice, stype, vtype ,slope,nroot,couple
       logical :: flag(im)
       logical :: snowng,frzgra
+
+      character(len=len(errmsg)) :: errmsg_col
+      integer                    :: errflg_col
       
       !  ---  local derived constants:
 
       real(kind=kind_phys) :: cpinv, hvapi, convrad, elocp
-      
-      type(noahmp_parameters) :: parameters
 
 !
 !===> ...  begin here
@@ -434,6 +448,61 @@
 !    nsoil   - number of soil layers (at least 2)
 !    sldpth  - the thickness of each soil layer (m)
 
+!  --- ...  the scheme options are the same for all the columns, they
+!           are module variables so set them once, outside of the
+!           threaded column loop
+
+      call noahmp_options(idveg ,iopt_crs,iopt_btr,iopt_run,iopt_sfc,   &
+     & iopt_frz,iopt_inf,iopt_rad,iopt_alb,iopt_snf,iopt_tbot,iopt_stc)
+
+      call noahmp_options_glacier                                       &
+     &   (idveg  ,iopt_crs  ,iopt_btr, iopt_run ,iopt_sfc ,iopt_frz,    &
+     &   iopt_inf ,iopt_rad ,iopt_alb ,iopt_snf ,iopt_tbot, iopt_stc )
+
+!  --- ...  the parameters of the land columns are read from the table
+!           of noahmpdrv_init, make sure their types are in it
+
+      if (.not. allocated(mp_table)) then
+        errmsg = 'noahmpdrv_run: noahmpdrv_init has not been called'
+        errflg = 1
+        return
+      endif
+      if (any(flag .and. (vegtype  < 1 .or. vegtype  > size(mp_table,1) &
+     &               .or. soiltyp  < 1 .or. soiltyp  > size(mp_table,2) &
+     &               .or. slopetyp < 1 .or. slopetyp > size(mp_table,3))&
+     &   )) then
+        errmsg = 'noahmpdrv_run: vegetation, soil or slope type of a '//
+     &           'land point out of range'
+        errflg = 1
+        return
+      endif
+
+!  --- ...  the columns are independent: thread over them, all the
+!           column scalars and work arrays are private to each thread
+
+!$omp parallel do schedule(guided) default(shared) firstprivate(nsoil)
+!$omp& private(k,ice,stype,vtype,slope,nroot,couple,snowng,frzgra)
+!$omp& private(alb,albedo,beta,chx,cmx,cmc,dew,drip,dqsdt2,ec,edir)
+!$omp& private(ett,eta,esnow,etp,flx1,flx2,flx3,ffrozp,lwdn,pc,prcp)
+!$omp& private(ptu,q2,q2sat,solnet,rc,rcs,rct,rcq,rcsoil,rsmin)
+!$omp& private(runoff1,runoff2,runoff3,sfcspd,sfcprs,sfctmp,sfcems)
+!$omp& private(sheat,shdfac,shdmin1d,shdmax1d,smcwlt,smcdry,smcref)
+!$omp& private(smcmax,sneqv,snoalb1d,snowh,snomlt,sncovr,soilw,soilm)
+!$omp& private(ssoil,tsea,th2,xlai,zlvl,swdn,psfc,fdown,t2v,tbot)
+!$omp& private(pconv,pnonc,pshcv,psnow,pgrpl,phail,lat,cosz,uu,vv)
+!$omp& private(swe,isnowx,tvx,tgx,canicex,canliqx,eahx,tahx,fwetx)
+!$omp& private(sneqvox,alboldx,qsnowx,wslakex,zwtx,wax,wtx,lfmassx)
+!$omp& private(rtmassx,stmassx,woodx,stblcpx,fastcpx,xlaix,xsaix)
+!$omp& private(taussx,smcwtdx,deeprechx,rechx,qsfc1d)
+!$omp& private(tsnox,snicex,snliqx,ficeold,smoiseqx,zsnsox,tsnsox)
+!$omp& private(albd,albi,et,stsoil,smsoil,slsoil)
+!$omp& private(z0wrf,fsa,fsr,fira,fsh,fcev,fgev,fctr,ecan,etran,trad)
+!$omp& private(tgb,tgv,t2mv,t2mb,q2v,q2b,runsrf,runsub,apar,psn,sav)
+!$omp& private(sag,fsno,nee,gpp,npp,fveg,qsnbot,ponding,ponding1)
+!$omp& private(ponding2,rssun,rssha,bgap,wgap,chv,chb,emissi,shg,shc)
+!$omp& private(shb,evg,evb,ghv,ghb,irg,irc,irb,tr,evc,chleaf,chuc)
+!$omp& private(chv2,chb2,fpice,pahv,pahg,pahb,pah,co2pp,o2pp,ch2b)
+!$omp& private(errmsg_col,errflg_col)
       do i = 1, im
 
         if (flag_iter(i) .and. flag(i)) then
@@ -665,20 +734,14 @@
 
 
 
-       call transfer_mp_parameters(vtype,stype,slope,isc,parameters)
-
-       call noahmp_options(idveg ,iopt_crs,iopt_btr,iopt_run,iopt_sfc,  &
-     & iopt_frz,iopt_inf,iopt_rad,iopt_alb,iopt_snf,iopt_tbot,iopt_stc)
+        errmsg_col = ''
+        errflg_col = 0
 
         if ( vtype == isice_table )  then
 
           ice = -1
           tbot = min(tbot,263.15)
 
-         call noahmp_options_glacier                                    &
-     &   (idveg  ,iopt_crs  ,iopt_btr, iopt_run ,iopt_sfc ,iopt_frz,    &
-     &   iopt_inf ,iopt_rad ,iopt_alb ,iopt_snf ,iopt_tbot, iopt_stc )
-
        call noahmp_glacier (                                            &
      &             i       ,1       ,cosz    ,nsnow   ,nsoil   ,delt  , & ! in : time/space/model-related
      &             sfctmp  ,sfcprs  ,uu      ,vv      ,q2      ,swdn  , & ! in : forcing
@@ -690,14 +753,20 @@
      &             trad    ,edir    ,runsrf  ,runsub  ,sag   ,albedo  , & ! out : albedo is surface albedo
      &             qsnbot  ,ponding ,ponding1,ponding2,t2mb  ,q2b     , & ! out :
 #ifdef CCPP
-     &             emissi  ,fpice   ,ch2b    ,esnow, albd, albi,errmsg, &
-     &             errflg )
+     &             emissi  ,fpice   ,ch2b    ,esnow, albd, albi,        &
+     &             errmsg_col, errflg_col )
 #else
      &             emissi  ,fpice   ,ch2b    ,esnow,albd, albi )
 #endif
 
 #ifdef CCPP
-       if (errflg /= 0) return
+       if (errflg_col /= 0) then
+!$omp critical (noahmpdrv_run_error)
+         errmsg = errmsg_col
+         errflg = errflg_col
+!$omp end critical (noahmpdrv_run_error)
+         cycle
+       endif
 #endif
 !
 ! in/out and outs
@@ -749,7 +818,7 @@
                  ice = 0 
 
 !        write(*,*)'tsnsox(1)=',tsnsox,'tgx=',tgx
-       call noahmp_sflx (parameters                                    ,&
+       call noahmp_sflx (mp_table(vtype,stype,slope)                   ,&
      &        i       , 1       , lat     , iyrlen  , julian  , cosz   ,& ! in : time/space-related
      &        delt    , dx      , dz8w    , nsoil   , zsoil   , nsnow  ,& ! in : model configuration 
      &        shdfac  , shdmax1d, vtype   , ice     , ist              ,& ! in : vegetation/soil 
@@ -779,13 +848,20 @@
      &        ghb     , irg     , irc     , irb     , tr      , evc    ,& ! out :
      &        chleaf  , chuc    , chv2    , chb2    , fpice   , pahv   ,& ! out
 #ifdef CCPP
-     &        pahg    , pahb    , pah     , esnow, errmsg, errflg   )
+     &        pahg    , pahb    , pah     , esnow, errmsg_col,          &
+     &        errflg_col   )
 #else
      &        pahg    , pahb    , pah     , esnow   )
 #endif
 
 #ifdef CCPP
-       if (errflg /= 0) return
+       if (errflg_col /= 0) then
+!$omp critical (noahmpdrv_run_error)
+         errmsg = errmsg_col
+         errflg = errflg_col
+!$omp end critical (noahmpdrv_run_error)
+         cycle
+       endif
 #endif
 
        eta  = fcev + fgev + fctr     ! the flux w/m2
@@ -921,6 +997,11 @@
 
         endif   ! end if_flag_iter_and_flag_block
       enddo   ! end do_i_loop
+!$omp end parallel do
+
+#ifdef CCPP
+      if (errflg /= 0) return
+#endif
 
 !   --- ...  compute qsurf (specific humidity at sfc)
 
@@ -1012,6 +1093,33 @@
 !> @}
 !-----------------------------------
 
+!> \ingroup NoahMP_LSM
+!! \brief This subroutine fills the table of noahmp_parameters: one
+!! transfer_mp_parameters() for each (vegtype, soiltype, slopetype) defined
+!! by set_soilveg(). It is built once, noahmpdrv_run only reads it.
+      subroutine mp_parameters_table()
+
+        use namelist_soilveg, only : defined_veg, defined_soil,         &
+     &                               defined_slope
+
+        implicit none
+
+        integer :: iveg, isoil, islope
+
+        if (allocated(mp_table)) deallocate(mp_table)
+        allocate(mp_table(defined_veg,defined_soil,defined_slope))
+
+        do islope = 1, defined_slope
+          do isoil = 1, defined_soil
+            do iveg = 1, defined_veg
+              call transfer_mp_parameters(iveg, isoil, islope, isc,     &
+     &                                    mp_table(iveg,isoil,islope))
+            enddo
+          enddo
+        enddo
+
+      end subroutine mp_parameters_table
+
 !> \ingroup NoahMP_LSM
 !! \brief This subroutine fills in a derived data type of type noahmp_parameters with data
 !! from the module \ref noahmp_tables.
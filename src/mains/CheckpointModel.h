@@ -41,27 +41,27 @@ namespace ucldas {
       const eckit::LocalConfiguration modelConfig(fullConfig, "model");
       const Model model(resol, modelConfig);
 
-      //  Setup state to write in the restart
-      const eckit::LocalConfiguration backgroundConfig(fullConfig,
-                                                       "background");
-      State xb(resol, backgroundConfig);
-      oops::Log::test() << "input background: " << std::endl << xb << std::endl;
+      //  Background, only read for reference: the analysis is handed over
+      //  to the model in memory and does not need it
+      if (fullConfig.has("background")) {
+        const eckit::LocalConfiguration backgroundConfig(fullConfig,
+                                                         "background");
+        State xb(resol, backgroundConfig);
+        oops::Log::test() << "input background: " << std::endl << xb
+                          << std::endl;
+      }
 
       //  Setup state to write in the restart
       const eckit::LocalConfiguration analysisConfig(fullConfig, "analysis");
       State xa(resol, analysisConfig);
       oops::Log::test() << "analysis: " << std::endl << xa << std::endl;
 
-      //  Initialize model
-      model.initialize(xb);
-
-      //  Set background to analysis
-      xb = xa;
-
-      //  Finalize model (dump restart)
-      model.finalize(xb);
+      //  Initialize model with the analysis, and finalize (hands the
+      //  analysis over to UCLAND and dumps the restart)
+      model.initialize(xa);
+      model.finalize(xa);
 
-      oops::Log::test() << "output background: " << std::endl << xb
+      oops::Log::test() << "output background: " << std::endl << xa
                         << std::endl;
 
       return 0;
@@ -5,12 +5,15 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include <string>
+
 #include "atlas/field.h"
 #include "atlas/functionspace.h"
 #include "atlas/grid.h"
 #include "atlas/util/Config.h"
 
 #include "eckit/config/YAMLConfiguration.h"
+#include "eckit/exception/Exceptions.h"
 
 #include "ucldas/Geometry/Geometry.h"
 
@@ -49,13 +52,12 @@ namespace ucldas {
     : comm_(other.comm_),
       atmconf_(other.atmconf_),
       initatm_(initAtm(other.atmconf_)),
-      fmsinput_(other.fmsinput_) {
+      fmsinput_(other.fmsinput_),
+      atlasFunctionSpace_(other.atlasFunctionSpace_) {
+    // The geometry is immutable, copies share the Fortran grid and the
+    // ATLAS function space instead of duplicating them
     const int key_geo = other.keyGeom_;
     ucldas_geo_clone_f90(keyGeom_, key_geo);
-    atlasFunctionSpace_.reset(new atlas::functionspace::PointCloud(
-                              other.atlasFunctionSpace_->lonlat()));
-    ucldas_geo_set_atlas_functionspace_pointer_f90(keyGeom_,
-      atlasFunctionSpace_->get());
     atlasFieldSet_.reset(new atlas::FieldSet());
     for (int jfield = 0; jfield < other.atlasFieldSet_->size(); ++jfield) {
       atlas::Field atlasField = other.atlasFieldSet_->field(jfield);
@@ -67,7 +69,19 @@ namespace ucldas {
     ucldas_geo_delete_f90(keyGeom_);
   }
   // -----------------------------------------------------------------------------
+  int Geometry::sharedCount() const {
+    int nref;
+    ucldas_geo_refcount_f90(keyGeom_, nref);
+    return nref;
+  }
+  // -----------------------------------------------------------------------------
   void Geometry::gridgen() const {
+    // gridgen rewrites the grid in place, which every copy would see
+    if (sharedCount() > 1) {
+      throw eckit::UserError("Geometry::gridgen: the grid is shared with "
+                             + std::to_string(sharedCount() - 1)
+                             + " other Geometry, gridgen needs its own", Here());
+    }
     ucldas_geo_gridgen_f90(keyGeom_);
   }
   // -----------------------------------------------------------------------------
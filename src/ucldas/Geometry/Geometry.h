@@ -58,8 +58,12 @@ namespace ucldas {
       std::vector<size_t> variableSizes(const oops::Variables & vars) const;
       std::vector<double> verticalCoord(std::string &) const {return {};}
 
+      /// Number of Geometry handles sharing the same Fortran grid
+      int sharedCount() const;
+
       int& toFortran() {return keyGeom_;}
       const int& toFortran() const {return keyGeom_;}
+      /// Regenerate the grid, only allowed when no other Geometry shares it
       void gridgen() const;
       const eckit::mpi::Comm & getComm() const {return comm_;}
       eckit::LocalConfiguration  getAtmConf() const {return atmconf_;}
@@ -80,7 +84,7 @@ namespace ucldas {
       eckit::LocalConfiguration atmconf_;
       bool initatm_;
       FmsInput fmsinput_;
-      std::unique_ptr<atlas::functionspace::PointCloud> atlasFunctionSpace_;
+      std::shared_ptr<atlas::functionspace::PointCloud> atlasFunctionSpace_;
       std::unique_ptr<atlas::FieldSet> atlasFieldSet_;
   };
   // -----------------------------------------------------------------------------
@@ -38,6 +38,7 @@ namespace ucldas {
     void ucldas_geo_fill_atlas_fieldset_f90(const F90geom &,
                                           atlas::field::FieldSetImpl *);
     void ucldas_geo_clone_f90(F90geom &, const F90geom &);
+    void ucldas_geo_refcount_f90(const F90geom &, int &);
     void ucldas_geo_gridgen_f90(const F90geom &);
     void ucldas_geo_delete_f90(F90geom &);
     void ucldas_geo_start_end_f90(const F90geom &, int &, int &, int &, int &);
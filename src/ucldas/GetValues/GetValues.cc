@@ -11,6 +11,7 @@
 
 #include "oops/mpi/mpi.h"
 #include "oops/util/DateTime.h"
+#include "oops/util/Timer.h"
 
 #include "ucldas/Geometry/Geometry.h"
 #include "ucldas/GetValues/GetValues.h"
@@ -45,6 +46,7 @@ void GetValues::fillGeoVaLs(const State & state,
                             const util::DateTime & t1,
                             const util::DateTime & t2,
                             ufo::GeoVaLs & geovals) const {
+  util::Timer timer(classname(), "fillGeoVaLs");
   // overwrite with atm geovals
   // NOTE this is a horrible hack. Remove soon?
   if (geom_->getAtmInit())
@@ -101,7 +103,10 @@ void GetValues::getValuesFromFile(const ufo::Locations & locs,
   }
 // -----------------------------------------------------------------------------
 void GetValues::print(std::ostream & os) const {
-  os << "GetValues" << std::endl;
+  int hits, misses;
+  ucldas_getvalues_cache_stats_f90(hits, misses);
+  os << "GetValues (interpolation cache: " << hits << " hits, "
+     << misses << " misses)" << std::endl;
 }
 // -----------------------------------------------------------------------------
 
@@ -52,6 +52,7 @@ extern "C" {
                                           const util::DateTime &,
                                           const ufo::Locations &,
                                           const F90goms &);
+  void ucldas_getvalues_cache_stats_f90(int &, int &);
 };  // extern "C"
 
 // -------------------------------------------------------------------------------------------------
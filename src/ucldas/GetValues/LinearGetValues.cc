@@ -6,6 +6,7 @@
  */
 
 #include "oops/util/DateTime.h"
+#include "oops/util/Timer.h"
 
 #include "ucldas/Geometry/Geometry.h"
 #include "ucldas/GetValues/GetValuesFortran.h"
@@ -45,6 +46,7 @@ void LinearGetValues::setTrajectory(const State & state,
                                     const util::DateTime & t1,
                                     const util::DateTime & t2,
                                     ufo::GeoVaLs & geovals) {
+  util::Timer timer(classname(), "setTrajectory");
   std::unique_ptr<State> varChangeState;
   const State * state_ptr;
 
@@ -75,6 +77,7 @@ void LinearGetValues::fillGeoVaLsTL(const Increment & incr,
                                     const util::DateTime & t1,
                                     const util::DateTime & t2,
                                     ufo::GeoVaLs & geovals) const {
+  util::Timer timer(classname(), "fillGeoVaLsTL");
   Increment incrGeovals(*geom_, geovals.getVars(), incr.validTime());
   linearmodel2geovals_->multiply(incr, incrGeovals);
   ucldas_getvalues_fill_geovals_tl_f90(keyLinearGetValues_,
@@ -88,6 +91,7 @@ void LinearGetValues::fillGeoVaLsAD(Increment & incr,
                                     const util::DateTime & t1,
                                     const util::DateTime & t2,
                                     const ufo::GeoVaLs & geovals) const {
+  util::Timer timer(classname(), "fillGeoVaLsAD");
   Increment incrGeovals(*geom_, geovals.getVars(), incr.validTime());
   ucldas_getvalues_fill_geovals_ad_f90(keyLinearGetValues_,
                                      geom_->toFortran(),
@@ -99,7 +103,10 @@ void LinearGetValues::fillGeoVaLsAD(Increment & incr,
 
 // -----------------------------------------------------------------------------
 void LinearGetValues::print(std::ostream & os) const {
-  os << "LinearGetValues" << std::endl;
+  int hits, misses;
+  ucldas_getvalues_cache_stats_f90(hits, misses);
+  os << "LinearGetValues (interpolation cache: " << hits << " hits, "
+     << misses << " misses)" << std::endl;
 }
 // -----------------------------------------------------------------------------
 
@@ -53,7 +53,7 @@ namespace ucldas {
   }
   // -----------------------------------------------------------------------------
   Increment::Increment(const Increment & other, const bool copy)
-    : time_(other.time_), vars_(other.vars_), geom_(new Geometry(*other.geom_))
+    : time_(other.time_), vars_(other.vars_), geom_(other.geom_)
   {
     ucldas_increment_create_f90(keyFlds_, geom_->toFortran(), vars_);
     if (copy) {
@@ -65,7 +65,7 @@ namespace ucldas {
   }
   // -----------------------------------------------------------------------------
   Increment::Increment(const Increment & other)
-    : time_(other.time_), vars_(other.vars_), geom_(new Geometry(*other.geom_))
+    : time_(other.time_), vars_(other.vars_), geom_(other.geom_)
   {
     ucldas_increment_create_f90(keyFlds_, geom_->toFortran(), vars_);
     ucldas_increment_copy_f90(toFortran(), other.toFortran());
@@ -156,35 +156,11 @@ namespace ucldas {
   // -----------------------------------------------------------------------------
   oops::LocalIncrement Increment::getLocal(
                         const GeometryIterator & iter) const {
-    int nx, ny, nzo, nf;
-    ucldas_increment_sizes_f90(toFortran(), nx, ny, nzo, nf);
-
-    std::vector<int> varlens(vars_.size());
-
-    // TODO(Travis) remove the hardcoded variable names
-    for (int ii = 0; ii < vars_.size(); ii++) {
-      if (vars_[ii] == "tocn") varlens[ii]=nzo;
-      else if (vars_[ii] == "socn") varlens[ii]=nzo;
-      else if (vars_[ii] == "hocn") varlens[ii]=nzo;
-      else if (vars_[ii] == "uocn") varlens[ii]=nzo;
-      else if (vars_[ii] == "vocn") varlens[ii]=nzo;
-      else if (vars_[ii] == "ssh")  varlens[ii]=1;
-      else if (vars_[ii] == "cicen") varlens[ii]=1;
-      else if (vars_[ii] == "hicen") varlens[ii]=1;
-      else if (vars_[ii] == "hsnon") varlens[ii]=1;
-      else if (vars_[ii] == "chl") varlens[ii]=nzo;
-      else if (vars_[ii] == "biop") varlens[ii]=nzo;
-      else
-          varlens[ii] = 0;
-    }
-
-    int lenvalues = std::accumulate(varlens.begin(), varlens.end(), 0);
-    std::vector<double> values(lenvalues);
-
+    const std::vector<int> & lens = varlens();
+    std::vector<double> values(std::accumulate(lens.begin(), lens.end(), 0));
     ucldas_increment_getpoint_f90(keyFlds_, iter.toFortran(), values[0],
                             values.size());
-
-    return oops::LocalIncrement(vars_, values, varlens);
+    return oops::LocalIncrement(vars_, values, lens);
   }
 
   // -----------------------------------------------------------------------------
@@ -194,6 +170,59 @@ namespace ucldas {
     ucldas_increment_setpoint_f90(toFortran(), iter.toFortran(), vals[0],
                             vals.size());
   }
+
+  // -----------------------------------------------------------------------------
+  void Increment::getLocals(const std::vector<GeometryIterator> & iters,
+                            std::vector<double> & values) const {
+    const std::vector<int> & lens = varlens();
+    const int npts = iters.size();
+    std::vector<F90iter> keys(npts);
+    for (int jj = 0; jj < npts; ++jj) keys[jj] = iters[jj].toFortran();
+    values.resize(npts * std::accumulate(lens.begin(), lens.end(), 0));
+    if (values.empty()) return;
+    ucldas_increment_getpoints_f90(keyFlds_, npts, keys[0], values[0],
+                                   values.size());
+  }
+
+  // -----------------------------------------------------------------------------
+  void Increment::setLocals(const std::vector<double> & values,
+                            const std::vector<GeometryIterator> & iters) {
+    const int npts = iters.size();
+    std::vector<F90iter> keys(npts);
+    for (int jj = 0; jj < npts; ++jj) keys[jj] = iters[jj].toFortran();
+    if (values.empty()) return;
+    ucldas_increment_setpoints_f90(keyFlds_, npts, keys[0], values[0],
+                                   values.size());
+  }
+
+  // -----------------------------------------------------------------------------
+  void Increment::getLocalsTile(std::vector<double> & values) const {
+    const std::vector<int> & lens = varlens();
+    int npts;
+    ucldas_increment_tile_npts_f90(keyFlds_, npts);
+    values.resize(npts * std::accumulate(lens.begin(), lens.end(), 0));
+    if (values.empty()) return;
+    ucldas_increment_gettile_f90(keyFlds_, values[0], values.size());
+  }
+
+  // -----------------------------------------------------------------------------
+  void Increment::setLocalsTile(const std::vector<double> & values) {
+    if (values.empty()) return;
+    ucldas_increment_settile_f90(keyFlds_, values[0], values.size());
+  }
+
+  // -----------------------------------------------------------------------------
+  const std::vector<int> & Increment::varlens() const {
+    // the number of levels of each field is set from the fields metadata
+    // when the increment is created, it only needs to be asked once
+    if (varlens_.size() != vars_.size()) {
+      varlens_.resize(vars_.size());
+      if (!varlens_.empty())
+        ucldas_increment_varlens_f90(keyFlds_, vars_.size(), varlens_[0]);
+    }
+    return varlens_;
+  }
+
   // -----------------------------------------------------------------------------
   /// ATLAS
   // -----------------------------------------------------------------------------
@@ -281,11 +310,11 @@ namespace ucldas {
     // Serialize the field
     size_t nn;
     ucldas_increment_serial_size_f90(toFortran(), geom_->toFortran(), nn);
-    std::vector<double> vect_field(nn, 0);
-    vect.reserve(vect.size() + nn + 1 + time_.serialSize());
+    const size_t offset = vect.size();
+    vect.reserve(offset + nn + 1 + time_.serialSize());
+    vect.resize(offset + nn);
     ucldas_increment_serialize_f90(toFortran(), geom_->toFortran(), nn,
-                                 vect_field.data());
-    vect.insert(vect.end(), vect_field.begin(), vect_field.end());
+                                 vect.data() + offset);
 
     // Magic value placed in serialization; used to validate deserialization
     vect.push_back(SerializeCheckValue);
@@ -89,6 +89,18 @@ namespace ucldas {
       oops::LocalIncrement getLocal(const GeometryIterator &) const;
       void setLocal(const oops::LocalIncrement &, const GeometryIterator &);
 
+      /// Batched Getpoint/Setpoint, for a list of points or for all the
+      /// points of the local domain (in GeometryIterator order). The values
+      /// of each point are contiguous, laid out as in a LocalIncrement.
+      void getLocals(const std::vector<GeometryIterator> &,
+                     std::vector<double> &) const;
+      void setLocals(const std::vector<double> &,
+                     const std::vector<GeometryIterator> &);
+      void getLocalsTile(std::vector<double> &) const;
+      void setLocalsTile(const std::vector<double> &);
+      /// Number of levels of each variable
+      const std::vector<int> & varlens() const;
+
       /// ATLAS
       void setAtlas(atlas::FieldSet *) const;
       void toAtlas(atlas::FieldSet *) const;
@@ -122,6 +134,7 @@ namespace ucldas {
       oops::Variables vars_;
       util::DateTime time_;
       std::shared_ptr<const Geometry> geom_;
+      mutable std::vector<int> varlens_;
   };
   // -----------------------------------------------------------------------------
 
@@ -74,6 +74,14 @@ namespace ucldas {
                            const int &);
     void ucldas_increment_setpoint_f90(F90flds &, const F90iter &, const double &,
                            const int &);
+    void ucldas_increment_varlens_f90(const F90flds &, const int &, int &);
+    void ucldas_increment_getpoints_f90(const F90flds &, const int &,
+                           const F90iter &, double &, const int &);
+    void ucldas_increment_setpoints_f90(F90flds &, const int &,
+                           const F90iter &, const double &, const int &);
+    void ucldas_increment_tile_npts_f90(const F90flds &, int &);
+    void ucldas_increment_gettile_f90(const F90flds &, double &, const int &);
+    void ucldas_increment_settile_f90(F90flds &, const double &, const int &);
     void ucldas_increment_sizes_f90(const F90flds &, int &,
                               int &, int &, int &);
     void ucldas_increment_rms_f90(const F90flds &, double &);
@@ -6,6 +6,7 @@
  */
 
 #include <iomanip>
+#include <string>
 #include <vector>
 
 #include "ucldas/Geometry/Geometry.h"
@@ -59,7 +60,7 @@ namespace ucldas {
   }
   // -----------------------------------------------------------------------------
   State::State(const State & other)
-    : vars_(other.vars_), time_(other.time_), geom_(new Geometry(*other.geom_))
+    : vars_(other.vars_), time_(other.time_), geom_(other.geom_)
   {
     ucldas_state_create_f90(keyFlds_, geom_->toFortran(), vars_);
     ucldas_state_copy_f90(toFortran(), other.toFortran());
@@ -95,6 +96,15 @@ namespace ucldas {
     ucldas_state_rotate2grid_f90(toFortran(), u, v);
   }
   // -----------------------------------------------------------------------------
+  /// Colocation
+  // -----------------------------------------------------------------------------
+  void State::colocate(const std::string & grid) {
+    Log::trace() << "State::State colocate to the " << grid << " grid."
+                 << std::endl;
+    ASSERT(grid == "h" || grid == "u" || grid == "v");
+    ucldas_state_colocate_f90(toFortran(), grid[0]);
+  }
+  // -----------------------------------------------------------------------------
   /// Interactions with Increments
   // -----------------------------------------------------------------------------
   State & State::operator+=(const Increment & dx) {
@@ -158,11 +168,11 @@ namespace ucldas {
     // Serialize the field
     size_t nn;
     ucldas_state_serial_size_f90(toFortran(), geom_->toFortran(), nn);
-    std::vector<double> vect_field(nn, 0);
-    vect.reserve(vect.size() + nn + 1 + time_.serialSize());
+    const size_t offset = vect.size();
+    vect.reserve(offset + nn + 1 + time_.serialSize());
+    vect.resize(offset + nn);
     ucldas_state_serialize_f90(toFortran(), geom_->toFortran(), nn,
-                             vect_field.data());
-    vect.insert(vect.end(), vect_field.begin(), vect_field.end());
+                             vect.data() + offset);
 
     // Magic value placed in serialization; used to validate deserialization
     vect.push_back(SerializeCheckValue);
@@ -65,6 +65,9 @@ namespace ucldas {
       void rotate2north(const oops::Variables &, const oops::Variables &) const;
       void rotate2grid(const oops::Variables &, const oops::Variables &) const;
 
+      /// Move all the fields to the same C-grid location ("h", "u" or "v")
+      void colocate(const std::string &);
+
       /// Logarithmic and exponential transformations
       void logtrans(const oops::Variables &) const;
       void expontrans(const oops::Variables &) const;
@@ -43,6 +43,7 @@ namespace ucldas {
     void ucldas_state_rotate2north_f90(const F90flds &,
                                      const oops::Variables &,
                                      const oops::Variables &);
+    void ucldas_state_colocate_f90(const F90flds &, const char &);
     void ucldas_state_logtrans_f90(const F90flds &, const oops::Variables &);
     void ucldas_state_expontrans_f90(const F90flds &, const oops::Variables &);
     void ucldas_state_gpnorm_f90(const F90flds &, const int &, double &);
@@ -5,9 +5,12 @@
  * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
  */
 
+#include "ucldas/State/State.h"
 #include "ucldas/Transforms/Model2GeoVaLs/Model2GeoVaLs.h"
 #include "ucldas/Transforms/Model2GeoVaLs/Model2GeoVaLsFortran.h"
 
+#include "eckit/config/Configuration.h"
+
 #include "oops/util/abor1_cpp.h"
 
 namespace ucldas {
@@ -24,7 +27,7 @@ static oops::VariableChangeMaker< Traits, Model2GeoVaLs>
 
 Model2GeoVaLs::Model2GeoVaLs(const Geometry & geom,
                              const eckit::Configuration & conf)
-  : geom_(new Geometry(geom)) {
+  : geom_(new Geometry(geom)), colocate_(conf.getString("colocate to", "")) {
 }
 
 // -----------------------------------------------------------------------------
@@ -36,6 +39,7 @@ Model2GeoVaLs::~Model2GeoVaLs() {}
 void Model2GeoVaLs::changeVar(const State & xin, State & xout) const {
   ucldas_model2geovals_changevar_f90(geom_->toFortran(),
                                    xin.toFortran(), xout.toFortran());
+  if (!colocate_.empty()) xout.colocate(colocate_);
 }
 
 // -----------------------------------------------------------------------------
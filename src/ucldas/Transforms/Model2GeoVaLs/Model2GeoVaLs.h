@@ -29,6 +29,9 @@ class Model2GeoVaLs: public oops::VariableChangeBase<Traits> {
 
  private:
   std::unique_ptr<Geometry> geom_;
+  /// C-grid location ("h", "u" or "v") the GeoVaLs fields are moved to
+  /// before the interpolation, empty to leave them on their own grid
+  std::string colocate_;
   void print(std::ostream &) const override {}
 };
 
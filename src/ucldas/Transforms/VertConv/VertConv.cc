@@ -12,6 +12,7 @@
 
 #include "oops/interface/LinearVariableChange.h"
 #include "oops/util/Logger.h"
+#include "oops/util/Timer.h"
 
 #include "ucldas/Geometry/Geometry.h"
 #include "ucldas/Increment/Increment.h"
@@ -37,6 +38,7 @@ namespace ucldas {
                      const eckit::Configuration & conf) :
           bkg_lr_(geom, bkg), geom_(geom) {
     oops::Log::trace() << "ucldas::VertConv::setup " << std::endl;
+    util::Timer timer(classname(), "setup");
     const eckit::Configuration * configc = &conf;
 
     // Compute convolution weights
@@ -54,6 +56,7 @@ namespace ucldas {
   void VertConv::multiply(const Increment & dxa, Increment & dxm) const {
     // dxm = K dxa
     oops::Log::trace() << "ucldas::VertConv::multiply " << std::endl;
+    util::Timer timer(classname(), "multiply");
     ucldas_vertconv_mult_f90(dxa.toFortran(), dxm.toFortran(), keyFtnConfig_);
   }
   // -----------------------------------------------------------------------------
@@ -65,6 +68,7 @@ namespace ucldas {
   void VertConv::multiplyAD(const Increment & dxm, Increment & dxa) const {
     // dxa = K^T dxm
     oops::Log::trace() << "ucldas::VertConv::multiplyAD " << std::endl;
+    util::Timer timer(classname(), "multiplyAD");
     ucldas_vertconv_multad_f90(dxm.toFortran(), dxa.toFortran(), keyFtnConfig_);
   }
   // -----------------------------------------------------------------------------
@@ -27,6 +27,8 @@ namespace ucldas {
                                 const F90balopmat &);
     void ucldas_vertconv_multad_f90(const F90balopmat &, F90balopmat &,
                                   const F90balopmat &);
+    void ucldas_vertconv_lookups_f90(const F90balopmat &, const bool &,
+                                     double &);
   }
 }  // namespace ucldas
 #endif  // UCLDAS_TRANSFORMS_VERTCONV_VERTCONVFORTRAN_H_
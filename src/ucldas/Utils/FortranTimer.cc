@@ -0,0 +1,27 @@
+/*
+ * (C) Copyright 2021-2021 UCAR
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <string>
+
+#include "oops/util/Timer.h"
+
+// -----------------------------------------------------------------------------
+/// util::Timer for the Fortran code (ucldas_timer_mod), so that the timings
+/// of the Fortran routines end up in the oops timing report
+namespace ucldas {
+
+  extern "C" {
+    util::Timer * ucldas_timer_start_f90(const char * cls, const char * method) {
+      return new util::Timer(std::string(cls), std::string(method));
+    }
+
+    void ucldas_timer_stop_f90(util::Timer * timer) {
+      delete timer;
+    }
+  }
+
+}  // namespace ucldas
@@ -0,0 +1,112 @@
+/*
+ * (C) Copyright 2021-2021 UCAR.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Run.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+
+#include "ucldas/Geometry/Geometry.h"
+#include "ucldas/State/State.h"
+
+namespace test {
+
+// -----------------------------------------------------------------------------
+/// Fields already on the requested grid are left untouched
+void testColocateSameGrid() {
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "colocate test");
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+
+  const ucldas::State xx(geom, eckit::LocalConfiguration(conf, "h state"));
+  ucldas::State yy(xx);
+  yy.colocate("h");
+  EXPECT(yy.norm() == xx.norm());
+}
+
+// -----------------------------------------------------------------------------
+/// The fields keep track of their new grid: a second colocation to the same
+/// grid does nothing, and the values stay close to the ones on the C-grid
+void testColocateToH() {
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "colocate test");
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  const double tol = conf.getDouble("tolerance");
+
+  const ucldas::State xx(geom, eckit::LocalConfiguration(conf, "uv state"));
+  ucldas::State yy(xx);
+  yy.colocate("h");
+  const double norm = yy.norm();
+  oops::Log::info() << "norm on the C-grid: " << xx.norm()
+                    << ", colocated on h: " << norm << std::endl;
+  EXPECT(std::abs(norm - xx.norm()) <= tol * xx.norm());
+
+  yy.colocate("h");
+  EXPECT(yy.norm() == norm);
+}
+
+// -----------------------------------------------------------------------------
+/// u -> v goes through the h grid, and h -> u, h -> v bring the fields back
+/// on the staggered points
+void testColocateRoundTrip() {
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "colocate test");
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  const double tol = conf.getDouble("tolerance");
+
+  const ucldas::State xx(geom, eckit::LocalConfiguration(conf, "uv state"));
+  for (const std::string grid : {"u", "v"}) {
+    ucldas::State yy(xx);
+    yy.colocate(grid);
+    yy.colocate("h");
+    yy.colocate(grid);
+    oops::Log::info() << "norm on the C-grid: " << xx.norm()
+                      << ", on " << grid << " after a round trip to h: "
+                      << yy.norm() << std::endl;
+    EXPECT(std::abs(yy.norm() - xx.norm()) <= tol * xx.norm());
+  }
+}
+
+// -----------------------------------------------------------------------------
+class Colocate : public oops::Test {
+ public:
+  Colocate() {}
+  virtual ~Colocate() {}
+
+ private:
+  std::string testid() const override {return "test::Colocate";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ucldas/Colocate/testColocateSameGrid")
+      { testColocateSameGrid(); });
+    ts.emplace_back(CASE("ucldas/Colocate/testColocateToH")
+      { testColocateToH(); });
+    ts.emplace_back(CASE("ucldas/Colocate/testColocateRoundTrip")
+      { testColocateRoundTrip(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+
+// -----------------------------------------------------------------------------
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  test::Colocate tests;
+  return run.execute(tests);
+}
@@ -0,0 +1,84 @@
+/*
+ * (C) Copyright 2017-2020 UCAR.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Run.h"
+#include "oops/runs/Test.h"
+#include "test/TestEnvironment.h"
+
+#include "ucldas/Geometry/Geometry.h"
+
+namespace test {
+
+// -----------------------------------------------------------------------------
+/// Copies of a Geometry share its Fortran grid, the count follows the copies
+void testSharedCount() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "geometry");
+  ucldas::Geometry geom(conf, oops::mpi::world());
+  EXPECT(geom.sharedCount() == 1);
+  {
+    ucldas::Geometry copy1(geom);
+    EXPECT(copy1.toFortran() == geom.toFortran());
+    EXPECT(geom.sharedCount() == 2);
+
+    std::unique_ptr<ucldas::Geometry> copy2(new ucldas::Geometry(copy1));
+    EXPECT(geom.sharedCount() == 3);
+    EXPECT(copy2->sharedCount() == 3);
+
+    copy2.reset();
+    EXPECT(copy1.sharedCount() == 2);
+  }
+  EXPECT(geom.sharedCount() == 1);
+}
+
+// -----------------------------------------------------------------------------
+/// gridgen regenerates the grid in place, it is refused on a shared Geometry
+void testGridgenShared() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "geometry");
+  ucldas::Geometry geom(conf, oops::mpi::world());
+  ucldas::Geometry copy(geom);
+  EXPECT_THROWS_AS(copy.gridgen(), eckit::UserError);
+  EXPECT(geom.sharedCount() == 2);
+}
+
+// -----------------------------------------------------------------------------
+class GeometryShared : public oops::Test {
+ public:
+  GeometryShared() {}
+  virtual ~GeometryShared() {}
+
+ private:
+  std::string testid() const override {return "test::GeometryShared";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ucldas/Geometry/testSharedCount")
+      { testSharedCount(); });
+    ts.emplace_back(CASE("ucldas/Geometry/testGridgenShared")
+      { testGridgenShared(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+
+// -----------------------------------------------------------------------------
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  test::GeometryShared tests;
+  return run.execute(tests);
+}
@@ -0,0 +1,119 @@
+/*
+ * (C) Copyright 2020-2020 UCAR.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Run.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Duration.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+
+#include "ufo/GeoVaLs.h"
+#include "ufo/Locations.h"
+
+#include "ucldas/Geometry/Geometry.h"
+#include "ucldas/GetValues/GetValues.h"
+#include "ucldas/State/State.h"
+
+namespace test {
+
+// -----------------------------------------------------------------------------
+/// Total cost of the interpolation over a 3DVar-FGAT window.
+///
+/// The window is split in slots of "slot length", as in FGAT. Each slot is
+/// interpolated once with the per time window interpolators, and once the way
+/// it was done before those, interpolating to every location of the window
+/// and keeping the ones of the slot. Both give the same GeoVaLs, the timings
+/// of the two are written to the log.
+void testFGATWindowCost() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "getvalues timing");
+  const eckit::LocalConfiguration locsConf(TestEnvironment::config(), "locations");
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration stateConf(TestEnvironment::config(), "state");
+
+  const util::DateTime winbgn(locsConf.getString("window begin"));
+  const util::DateTime winend(locsConf.getString("window end"));
+  const util::Duration slot(conf.getString("slot length"));
+  const double tol = conf.getDouble("tolerance");
+  const oops::Variables vars(conf, "state variables");
+
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  const ucldas::State state(geom, stateConf);
+  const ufo::Locations locs(locsConf, oops::mpi::world());
+
+  // per time window interpolators, each slot only touches its own locations
+  ucldas::GetValues slotted(geom, locs, conf);
+  ufo::GeoVaLs gvSlotted(locs, vars);
+  double tSlotted = 0.0;
+  int nslots = 0;
+  for (util::DateTime t1 = winbgn; t1 < winend; t1 += slot) {
+    const util::DateTime t2 = std::min(t1 + slot, winend);
+    const auto start = std::chrono::steady_clock::now();
+    slotted.fillGeoVaLs(state, t1, t2, gvSlotted);
+    tSlotted += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ++nslots;
+  }
+
+  // every slot interpolates to all the locations of the window, then keeps
+  // those of the slot, the cost of fillGeoVaLs before the per window split
+  ucldas::GetValues whole(geom, locs, conf);
+  ufo::GeoVaLs gvWhole(locs, vars);
+  double tWhole = 0.0;
+  for (int islot = 0; islot < nslots; ++islot) {
+    const auto start = std::chrono::steady_clock::now();
+    whole.fillGeoVaLs(state, winbgn, winend, gvWhole);
+    tWhole += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  oops::Log::info() << "GetValues over " << nslots << " slots of " << slot
+                    << ":" << std::endl
+                    << "  per slot interpolators   : " << tSlotted << " s" << std::endl
+                    << "  whole window per slot    : " << tWhole << " s" << std::endl
+                    << "  speedup                  : " << tWhole / tSlotted << std::endl;
+
+  ufo::GeoVaLs diff(gvSlotted);
+  diff -= gvWhole;
+  EXPECT(diff.rms() <= tol * gvWhole.rms());
+}
+
+// -----------------------------------------------------------------------------
+class GetValuesTiming : public oops::Test {
+ public:
+  GetValuesTiming() {}
+  virtual ~GetValuesTiming() {}
+
+ private:
+  std::string testid() const override {return "test::GetValuesTiming";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ucldas/GetValues/testFGATWindowCost")
+      { testFGATWindowCost(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+
+// -----------------------------------------------------------------------------
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  test::GetValuesTiming tests;
+  return run.execute(tests);
+}
@@ -0,0 +1,149 @@
+/*
+ * (C) Copyright 2021-2021 UCAR.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/base/LocalIncrement.h"
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Run.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+
+#include "ucldas/Geometry/Geometry.h"
+#include "ucldas/GeometryIterator/GeometryIterator.h"
+#include "ucldas/Increment/Increment.h"
+
+namespace test {
+
+// -----------------------------------------------------------------------------
+/// All the points of the local domain, in GeometryIterator order
+std::vector<ucldas::GeometryIterator> allPoints(const ucldas::Geometry & geom) {
+  std::vector<ucldas::GeometryIterator> iters;
+  for (ucldas::GeometryIterator it = geom.begin(); it != geom.end(); ++it) {
+    iters.push_back(it);
+  }
+  return iters;
+}
+
+// -----------------------------------------------------------------------------
+/// The batched getLocals/getLocalsTile give the same values as getLocal
+/// called point by point, with all the levels of every variable.
+void testGetLocals() {
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "increment test");
+  const oops::Variables vars(TestEnvironment::config(), "inc variables");
+  const util::DateTime date(conf.getString("date"));
+
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  ucldas::Increment dx(geom, vars, date);
+  dx.random();
+
+  const std::vector<ucldas::GeometryIterator> iters = allPoints(geom);
+  const std::vector<size_t> nlevs = geom.variableSizes(vars);
+  const std::vector<int> & lens = dx.varlens();
+  EXPECT(lens.size() == nlevs.size());
+  for (size_t jv = 0; jv < lens.size(); ++jv) {
+    EXPECT(lens[jv] == static_cast<int>(nlevs[jv]));
+  }
+
+  std::vector<double> expected;
+  for (const ucldas::GeometryIterator & it : iters) {
+    const std::vector<double> vals = dx.getLocal(it).getVals();
+    expected.insert(expected.end(), vals.begin(), vals.end());
+  }
+
+  std::vector<double> batched;
+  dx.getLocals(iters, batched);
+  EXPECT(batched == expected);
+
+  std::vector<double> tile;
+  dx.getLocalsTile(tile);
+  EXPECT(tile == expected);
+
+  oops::Log::info() << "getLocals: " << iters.size() << " points, "
+                    << expected.size() << " values" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+/// setLocals/setLocalsTile give the same increment as setLocal called point
+/// by point with the values of another increment, which is copied exactly.
+void testSetLocals() {
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "increment test");
+  const oops::Variables vars(TestEnvironment::config(), "inc variables");
+  const util::DateTime date(conf.getString("date"));
+
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  ucldas::Increment dx(geom, vars, date);
+  dx.random();
+
+  const std::vector<ucldas::GeometryIterator> iters = allPoints(geom);
+
+  ucldas::Increment dxPoint(geom, vars, date);
+  dxPoint.zero();
+  for (const ucldas::GeometryIterator & it : iters) {
+    dxPoint.setLocal(dx.getLocal(it), it);
+  }
+
+  std::vector<double> values;
+  dx.getLocals(iters, values);
+
+  ucldas::Increment dxBatched(geom, vars, date);
+  dxBatched.zero();
+  dxBatched.setLocals(values, iters);
+
+  ucldas::Increment dxTile(geom, vars, date);
+  dxTile.zero();
+  dxTile.setLocalsTile(values);
+
+  ucldas::Increment diff(dxBatched);
+  diff -= dxPoint;
+  EXPECT(diff.norm() == 0.0);
+  diff = dxTile;
+  diff -= dxPoint;
+  EXPECT(diff.norm() == 0.0);
+  diff = dxPoint;
+  diff -= dx;
+  EXPECT(diff.norm() == 0.0);
+}
+
+// -----------------------------------------------------------------------------
+class IncrementLocals : public oops::Test {
+ public:
+  IncrementLocals() {}
+  virtual ~IncrementLocals() {}
+
+ private:
+  std::string testid() const override {return "test::IncrementLocals";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ucldas/Increment/testGetLocals")
+      { testGetLocals(); });
+    ts.emplace_back(CASE("ucldas/Increment/testSetLocals")
+      { testSetLocals(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+
+// -----------------------------------------------------------------------------
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  test::IncrementLocals tests;
+  return run.execute(tests);
+}
@@ -0,0 +1,111 @@
+/*
+ * (C) Copyright 2021-2021 UCAR.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Run.h"
+#include "oops/runs/Test.h"
+#include "oops/util/DateTime.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+
+#include "ucldas/Geometry/Geometry.h"
+#include "ucldas/Increment/Increment.h"
+#include "ucldas/State/State.h"
+
+namespace test {
+
+// -----------------------------------------------------------------------------
+/// A state read back from its serialization is the same state, also when the
+/// buffer already holds other data
+void testStateRoundTrip() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "serialize test");
+  const ucldas::Geometry geom(eckit::LocalConfiguration(TestEnvironment::config(), "geometry"),
+                              oops::mpi::world());
+
+  const ucldas::State xx(geom, eckit::LocalConfiguration(conf, "state"));
+  std::vector<double> vect = {1.0, 2.0};
+  xx.serialize(vect);
+  EXPECT(vect.size() == 2 + xx.serialSize());
+
+  ucldas::State yy(geom, xx.variables(), xx.validTime());
+  size_t index = 2;
+  yy.deserialize(vect, index);
+  EXPECT(index == vect.size());
+
+  ucldas::Increment dx(geom, xx.variables(), xx.validTime());
+  dx.diff(xx, yy);
+  EXPECT(dx.norm() == 0.0);
+}
+
+// -----------------------------------------------------------------------------
+/// Increment round trip, with all the points or only the wet points of the
+/// masked fields in the buffer
+void testIncrementRoundTrip() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "serialize test");
+  const oops::Variables vars(conf, "increment variables");
+  const util::DateTime date(conf.getString("date"));
+
+  size_t sizes[2];
+  int n = 0;
+  for (const std::string geomName : {"geometry", "geometry wet only"}) {
+    const ucldas::Geometry geom(eckit::LocalConfiguration(TestEnvironment::config(), geomName),
+                                oops::mpi::world());
+    ucldas::Increment dx(geom, vars, date);
+    dx.random();
+
+    std::vector<double> vect;
+    dx.serialize(vect);
+    sizes[n++] = vect.size();
+
+    ucldas::Increment dy(geom, vars, date);
+    size_t index = 0;
+    dy.deserialize(vect, index);
+    EXPECT(index == vect.size());
+    dy -= dx;
+    EXPECT(dy.norm() == 0.0);
+  }
+  oops::Log::info() << "serialized increment size: " << sizes[0]
+                    << ", wet points only: " << sizes[1] << std::endl;
+  EXPECT(sizes[1] < sizes[0]);
+}
+
+// -----------------------------------------------------------------------------
+class Serialize : public oops::Test {
+ public:
+  Serialize() {}
+  virtual ~Serialize() {}
+
+ private:
+  std::string testid() const override {return "test::Serialize";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ucldas/Serialize/testStateRoundTrip")
+      { testStateRoundTrip(); });
+    ts.emplace_back(CASE("ucldas/Serialize/testIncrementRoundTrip")
+      { testIncrementRoundTrip(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+
+// -----------------------------------------------------------------------------
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  test::Serialize tests;
+  return run.execute(tests);
+}
@@ -0,0 +1,174 @@
+/*
+ * (C) Copyright 2021-2021 UCAR.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "oops/base/Variables.h"
+#include "oops/mpi/mpi.h"
+#include "oops/runs/Run.h"
+#include "oops/runs/Test.h"
+#include "oops/util/Logger.h"
+#include "test/TestEnvironment.h"
+
+#include "ucldas/Geometry/Geometry.h"
+#include "ucldas/Increment/Increment.h"
+#include "ucldas/State/State.h"
+#include "ucldas/Transforms/VertConv/VertConv.h"
+#include "ucldas/Transforms/VertConv/VertConvFortran.h"
+
+namespace test {
+
+// -----------------------------------------------------------------------------
+/// Cost of one application of the vertical convolution (K then K^T, as in B).
+///
+/// The correlations are built once when VertConv is constructed, the
+/// operator is then applied "applications" times. Before they were stored,
+/// the correlations were recomputed from the background in every
+/// application, which is timed here by building a new VertConv for each
+/// application. Both give the same increment, the cost per application of
+/// the two is written to the log.
+void testVertConvCost() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "vertconv timing");
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration bkgConf(TestEnvironment::config(), "background");
+
+  const int napply = conf.getInt("applications");
+  const double tol = conf.getDouble("tolerance");
+  const oops::Variables vars(conf, "increment variables");
+
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  const ucldas::State bkg(geom, bkgConf);
+
+  ucldas::Increment dx(geom, vars, bkg.validTime());
+  dx.random();
+  ucldas::Increment tmp(dx, false);
+
+  // correlations stored at setup
+  ucldas::Increment dxStored(dx, false);
+  double tStored = 0.0;
+  {
+    const auto start = std::chrono::steady_clock::now();
+    const ucldas::VertConv vc(bkg, bkg, geom, conf);
+    const double tSetup =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    oops::Log::info() << "VertConv setup: " << tSetup << " s" << std::endl;
+    for (int i = 0; i < napply; ++i) {
+      const auto t0 = std::chrono::steady_clock::now();
+      vc.multiply(dx, tmp);
+      vc.multiplyAD(tmp, dxStored);
+      tStored += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+  }
+
+  // correlations recomputed from the background in every application
+  ucldas::Increment dxRecomputed(dx, false);
+  double tRecomputed = 0.0;
+  for (int i = 0; i < napply; ++i) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const ucldas::VertConv vc(bkg, bkg, geom, conf);
+    vc.multiply(dx, tmp);
+    vc.multiplyAD(tmp, dxRecomputed);
+    tRecomputed += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  }
+
+  const std::vector<size_t> nlevs = geom.variableSizes(vars);
+  oops::Log::info() << "VertConv K K^T, "
+                    << *std::max_element(nlevs.begin(), nlevs.end()) << " levels, "
+                    << napply << " applications:" << std::endl
+                    << "  stored correlations      : " << tStored / napply
+                    << " s per application" << std::endl
+                    << "  recomputed correlations  : " << tRecomputed / napply
+                    << " s per application" << std::endl
+                    << "  speedup                  : " << tRecomputed / tStored << std::endl;
+
+  ucldas::Increment diff(dxStored);
+  diff -= dxRecomputed;
+  EXPECT(diff.norm() <= tol * dxRecomputed.norm());
+}
+
+// -----------------------------------------------------------------------------
+/// Cost of the background lookups of one application (hocn, mld and
+/// layer_depth for every wet column), now done once at setup.
+///
+/// They are timed with the linear search on the names that ucldas_fields
+/// used to do, and with the name index. Both find the same fields, the cost
+/// per application of the two is written to the log.
+void testLookupCost() {
+  const eckit::LocalConfiguration conf(TestEnvironment::config(), "vertconv timing");
+  const eckit::LocalConfiguration geomConf(TestEnvironment::config(), "geometry");
+  const eckit::LocalConfiguration bkgConf(TestEnvironment::config(), "background");
+
+  const int napply = conf.getInt("applications");
+
+  const ucldas::Geometry geom(geomConf, oops::mpi::world());
+  const ucldas::State bkg(geom, bkgConf);
+
+  int key;
+  const eckit::Configuration * configc = &conf;
+  ucldas::ucldas_vertconv_setup_f90(key, &configc, bkg.toFortran(), geom.toFortran());
+
+  double sumScan = 0.0;
+  double sumIndex = 0.0;
+  double tScan = 0.0;
+  double tIndex = 0.0;
+  for (int i = 0; i < napply; ++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    ucldas::ucldas_vertconv_lookups_f90(key, true, sumScan);
+    tScan += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    t0 = std::chrono::steady_clock::now();
+    ucldas::ucldas_vertconv_lookups_f90(key, false, sumIndex);
+    tIndex += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  }
+  ucldas::ucldas_vertconv_delete_f90(key);
+
+  oops::Log::info() << "VertConv background lookups, " << napply << " applications:"
+                    << std::endl
+                    << "  linear search            : " << tScan / napply
+                    << " s per application" << std::endl
+                    << "  name index               : " << tIndex / napply
+                    << " s per application" << std::endl
+                    << "  resolved at setup        : 0 s per application" << std::endl;
+
+  EXPECT(sumScan == sumIndex);
+}
+
+// -----------------------------------------------------------------------------
+class VertConvTiming : public oops::Test {
+ public:
+  VertConvTiming() {}
+  virtual ~VertConvTiming() {}
+
+ private:
+  std::string testid() const override {return "test::VertConvTiming";}
+
+  void register_tests() const override {
+    std::vector<eckit::testing::Test>& ts = eckit::testing::specification();
+
+    ts.emplace_back(CASE("ucldas/VertConv/testVertConvCost")
+      { testVertConvCost(); });
+    ts.emplace_back(CASE("ucldas/VertConv/testLookupCost")
+      { testLookupCost(); });
+  }
+
+  void clear() const override {}
+};
+
+}  // namespace test
+
+// -----------------------------------------------------------------------------
+int main(int argc,  char ** argv) {
+  oops::Run run(argc, argv);
+  test::VertConvTiming tests;
+  return run.execute(tests);
+}